@@ -71,9 +71,18 @@ wxString ExpandTextVars( const wxString& aSource, const PROJECT* aProject )
 wxString ExpandTextVars( const wxString& aSource,
                          const std::function<bool( wxString* )>* aResolver )
 {
-    static wxRegEx userDefinedWarningError( wxS( "^(ERC|DRC)_(WARNING|ERROR).*$" ) );
-    wxString       newbuf;
-    size_t         sourceLen = aSource.length();
+    // Not a wxRegEx: it keeps the state of its last match, and text variables are expanded
+    // from several threads at once.
+    auto isUserDefinedWarningError =
+            []( const wxString& aToken )
+            {
+                return ( aToken.StartsWith( wxS( "ERC_" ) ) || aToken.StartsWith( wxS( "DRC_" ) ) )
+                        && ( aToken.Mid( 4 ).StartsWith( wxS( "WARNING" ) )
+                             || aToken.Mid( 4 ).StartsWith( wxS( "ERROR" ) ) );
+            };
+
+    wxString newbuf;
+    size_t   sourceLen = aSource.length();
 
     newbuf.Alloc( sourceLen );  // best guess (improves performance)
 
@@ -94,7 +103,7 @@ wxString ExpandTextVars( const wxString& aSource,
             if( token.IsEmpty() )
                 continue;
 
-            if( userDefinedWarningError.Matches( token ) )
+            if( isUserDefinedWarningError( token ) )
             {
                 // Only show user-defined warnings/errors during ERC/DRC
             }
@@ -46,6 +46,7 @@
 #include <geometry/shape_compound.h>
 #include <geometry/shape_simple.h>
 #include <font/outline_font.h>
+#include <font/stroke_text_cache.h>
 #include <geometry/shape_poly_set.h>
 #include <properties/property_validators.h>
 #include <ctl_flags.h>         // for CTL_OMIT_HIDE definition
@@ -1009,6 +1010,18 @@ std::shared_ptr<SHAPE_COMPOUND> EDA_TEXT::GetEffectiveTextShape( bool aTriangula
             cache = GetRenderCache( font, shownText, VECTOR2I() );
     }
 
+    if( font->IsStroke() )
+    {
+        // Identical texts (reference designators and such) share their strokes
+        for( const SEG& seg : KIFONT::STROKE_TEXT_CACHE::GetInstance().GetStrokes(
+                     font, shownText, drawPos, attrs, getFontMetrics() ) )
+        {
+            shape->AddShape( new SHAPE_SEGMENT( seg, penWidth ) );
+        }
+
+        return shape;
+    }
+
     if( aTriangulate )
     {
         CALLBACK_GAL callback_gal(
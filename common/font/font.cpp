@@ -134,10 +134,18 @@ FONT::FONT()
 }
 
 
+// Fonts may be looked up from several threads (plotting layers concurrently, for instance)
+static std::once_flag s_defaultFontOnce;
+static std::mutex     s_fontMapMutex;
+
+
 FONT* FONT::getDefaultFont()
 {
-    if( !s_defaultFont )
-        s_defaultFont = STROKE_FONT::LoadFont( wxEmptyString );
+    std::call_once( s_defaultFontOnce,
+                    []()
+                    {
+                        s_defaultFont = STROKE_FONT::LoadFont( wxEmptyString );
+                    } );
 
     return s_defaultFont;
 }
@@ -150,6 +158,8 @@ FONT* FONT::GetFont( const wxString& aFontName, bool aBold, bool aItalic, const
 
     std::tuple<wxString, bool, bool> key = { aFontName, aBold, aItalic };
 
+    std::lock_guard<std::mutex> lock( s_fontMapMutex );
+
     FONT* font = nullptr;
 
     if( s_fontMap.find( key ) != s_fontMap.end() )
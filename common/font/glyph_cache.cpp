@@ -0,0 +1,467 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <font/glyph_cache.h>
+
+#include <paths.h>
+#include <trace_helpers.h>
+
+#include <wx/datstrm.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+#include <wx/wfstream.h>
+
+#include <algorithm>
+
+using namespace KIFONT;
+
+
+/// Default number of glyphs kept in the cache.  A glyph with its triangulation is typically a
+/// few KiB, so this bounds the cache (and its file) to some tens of MiB.
+static const size_t DEFAULT_MAX_GLYPHS = 20000;
+
+/// Written at the start of the cache file; bump the version when the layout changes.
+static const uint32_t GLYPH_CACHE_MAGIC = 0x4B494743;     // "KIGC"
+static const uint32_t GLYPH_CACHE_VERSION = 1;
+
+/// Smallest size in the file of a glyph entry, contour and triangulated polygon, and of their
+/// points, vertices and triangles.  Used to reject counts a corrupt file cannot hold.
+static const uint64_t MIN_ENTRY_SIZE = 4 + 4 + 8 + 1 + 8 + 4 + 4;
+static const uint64_t MIN_CONTOUR_SIZE = 4 + 4 + 4;
+static const uint64_t POINT_SIZE = 8 + 8;
+static const uint64_t MIN_POLY_SIZE = 4 + 4 + 4;
+static const uint64_t VERTEX_SIZE = 4 + 4;
+static const uint64_t TRIANGLE_SIZE = 4 + 4 + 4;
+
+
+GLYPH_CACHE::GLYPH_CACHE() :
+        m_maxSize( DEFAULT_MAX_GLYPHS ),
+        m_modified( false )
+{
+}
+
+
+GLYPH_CACHE& GLYPH_CACHE::GetInstance()
+{
+    static GLYPH_CACHE s_instance;
+    return s_instance;
+}
+
+
+uint32_t GLYPH_CACHE::GetFontId( const std::string& aFontName )
+{
+    std::lock_guard<std::mutex> lock( m_fontMutex );
+
+    auto it = m_fontIds.find( aFontName );
+
+    if( it != m_fontIds.end() )
+        return it->second;
+
+    m_fontNames.push_back( aFontName );
+
+    uint32_t id = static_cast<uint32_t>( m_fontNames.size() );
+    m_fontIds[aFontName] = id;
+
+    return id;
+}
+
+
+GLYPH_CACHE::SHARD& GLYPH_CACHE::shard( const GLYPH_CACHE_KEY& aKey )
+{
+    return m_shards[std::hash<GLYPH_CACHE_KEY>()( aKey ) % SHARD_COUNT];
+}
+
+
+size_t GLYPH_CACHE::shardMaxSize() const
+{
+    return std::max<size_t>( 1, ( m_maxSize + SHARD_COUNT - 1 ) / SHARD_COUNT );
+}
+
+
+std::shared_ptr<const GLYPH_DATA> GLYPH_CACHE::Get( const GLYPH_CACHE_KEY& aKey )
+{
+    SHARD&                      cacheShard = shard( aKey );
+    std::lock_guard<std::mutex> lock( cacheShard.m_mutex );
+
+    auto it = cacheShard.m_entries.find( aKey );
+
+    if( it == cacheShard.m_entries.end() )
+        return nullptr;
+
+    cacheShard.m_lru.splice( cacheShard.m_lru.begin(), cacheShard.m_lru, it->second.m_lruPos );
+
+    return it->second.m_data;
+}
+
+
+void GLYPH_CACHE::Put( const GLYPH_CACHE_KEY& aKey, std::shared_ptr<const GLYPH_DATA> aData )
+{
+    SHARD&                      cacheShard = shard( aKey );
+    std::lock_guard<std::mutex> lock( cacheShard.m_mutex );
+
+    m_modified = true;
+
+    auto it = cacheShard.m_entries.find( aKey );
+
+    if( it != cacheShard.m_entries.end() )
+    {
+        it->second.m_data = std::move( aData );
+        cacheShard.m_lru.splice( cacheShard.m_lru.begin(), cacheShard.m_lru, it->second.m_lruPos );
+        return;
+    }
+
+    cacheShard.m_lru.push_front( aKey );
+    cacheShard.m_entries[aKey] = { std::move( aData ), cacheShard.m_lru.begin() };
+
+    trim( cacheShard );
+}
+
+
+void GLYPH_CACHE::Clear()
+{
+    for( SHARD& cacheShard : m_shards )
+    {
+        std::lock_guard<std::mutex> lock( cacheShard.m_mutex );
+
+        cacheShard.m_entries.clear();
+        cacheShard.m_lru.clear();
+    }
+}
+
+
+size_t GLYPH_CACHE::GetSize() const
+{
+    size_t size = 0;
+
+    for( SHARD& cacheShard : m_shards )
+    {
+        std::lock_guard<std::mutex> lock( cacheShard.m_mutex );
+
+        size += cacheShard.m_entries.size();
+    }
+
+    return size;
+}
+
+
+void GLYPH_CACHE::SetMaxSize( size_t aMaxSize )
+{
+    m_maxSize = aMaxSize;
+
+    for( SHARD& cacheShard : m_shards )
+    {
+        std::lock_guard<std::mutex> lock( cacheShard.m_mutex );
+
+        trim( cacheShard );
+    }
+}
+
+
+void GLYPH_CACHE::trim( SHARD& aShard )
+{
+    size_t maxSize = shardMaxSize();
+
+    while( aShard.m_entries.size() > maxSize )
+    {
+        aShard.m_entries.erase( aShard.m_lru.back() );
+        aShard.m_lru.pop_back();
+    }
+}
+
+
+wxString GLYPH_CACHE::GetDefaultCacheFile()
+{
+    wxFileName fn( PATHS::GetUserCachePath(), wxS( "glyph_cache.bin" ) );
+
+    return fn.GetFullPath();
+}
+
+
+bool GLYPH_CACHE::Load( const wxString& aFileName )
+{
+    if( !wxFileName::FileExists( aFileName ) )
+        return false;
+
+    wxFFileInputStream fis( aFileName );
+
+    if( !fis.IsOk() )
+        return false;
+
+    wxDataInputStream in( fis );
+    wxFileOffset      length = fis.GetLength();
+
+    // Every count read from the file is checked against what is left of it, so a truncated or
+    // corrupt file cannot make us allocate more than its size.
+    auto fits =
+            [&]( uint64_t aCount, uint64_t aItemSize ) -> bool
+            {
+                wxFileOffset remaining = length - fis.TellI();
+
+                return fis.IsOk() && remaining >= 0
+                        && aCount <= static_cast<uint64_t>( remaining ) / aItemSize;
+            };
+
+    auto corrupt =
+            [&]() -> bool
+            {
+                wxLogTrace( traceFonts, wxS( "Ignoring corrupt glyph cache %s" ), aFileName );
+                return false;
+            };
+
+    if( length < 12 || in.Read32() != GLYPH_CACHE_MAGIC || in.Read32() != GLYPH_CACHE_VERSION )
+    {
+        wxLogTrace( traceFonts, wxS( "Ignoring outdated glyph cache %s" ), aFileName );
+        return false;
+    }
+
+    uint32_t count = in.Read32();
+
+    if( !fits( count, MIN_ENTRY_SIZE ) )
+        return corrupt();
+
+    // Entries are stored most recently used first; insert them in reverse so the LRU order is
+    // preserved.
+    std::vector<std::pair<GLYPH_CACHE_KEY, std::shared_ptr<const GLYPH_DATA>>> entries;
+    entries.reserve( std::min<size_t>( count, m_maxSize ) );
+
+    for( uint32_t ii = 0; ii < count; ++ii )
+    {
+        uint32_t nameLength = in.Read32();
+
+        if( !fits( nameLength, 1 ) )
+            return corrupt();
+
+        std::string fontName( nameLength, '\0' );
+        fis.Read( fontName.data(), nameLength );
+
+        GLYPH_CACHE_KEY key;
+        key.fontId = GetFontId( fontName );
+        key.codepoint = in.Read32();
+        key.scaler = in.ReadDouble();
+
+        uint8_t flags = in.Read8();
+        key.fakeItalic = flags & 1;
+        key.fakeBold = flags & 2;
+        key.mirror = flags & 4;
+        key.angle = EDA_ANGLE( in.ReadDouble(), DEGREES_T );
+
+        auto     data = std::make_shared<GLYPH_DATA>();
+        uint32_t contourCount = in.Read32();
+
+        if( !fits( contourCount, MIN_CONTOUR_SIZE ) )
+            return corrupt();
+
+        data->m_Contours.resize( contourCount );
+
+        for( CONTOUR& contour : data->m_Contours )
+        {
+            contour.m_Winding = static_cast<int32_t>( in.Read32() );
+            contour.m_Orientation = static_cast<FT_Orientation>( in.Read32() );
+
+            uint32_t pointCount = in.Read32();
+
+            if( !fits( pointCount, POINT_SIZE ) )
+                return corrupt();
+
+            contour.m_Points.resize( pointCount );
+
+            for( VECTOR2D& pt : contour.m_Points )
+            {
+                pt.x = in.ReadDouble();
+                pt.y = in.ReadDouble();
+            }
+        }
+
+        uint32_t polyCount = in.Read32();
+
+        if( !fits( polyCount, MIN_POLY_SIZE ) )
+            return corrupt();
+
+        for( uint32_t jj = 0; jj < polyCount; ++jj )
+        {
+            auto poly = std::make_unique<SHAPE_POLY_SET::TRIANGULATED_POLYGON>(
+                    static_cast<int32_t>( in.Read32() ) );
+
+            uint32_t vertexCount = in.Read32();
+
+            if( !fits( vertexCount, VERTEX_SIZE ) )
+                return corrupt();
+
+            for( uint32_t kk = 0; kk < vertexCount; ++kk )
+            {
+                int32_t x = static_cast<int32_t>( in.Read32() );
+                int32_t y = static_cast<int32_t>( in.Read32() );
+                poly->AddVertex( VECTOR2I( x, y ) );
+            }
+
+            uint32_t triangleCount = in.Read32();
+
+            if( !fits( triangleCount, TRIANGLE_SIZE ) )
+                return corrupt();
+
+            for( uint32_t kk = 0; kk < triangleCount; ++kk )
+            {
+                uint32_t a = in.Read32();
+                uint32_t b = in.Read32();
+                uint32_t c = in.Read32();
+
+                if( a >= vertexCount || b >= vertexCount || c >= vertexCount )
+                    return corrupt();
+
+                poly->AddTriangle( a, b, c );
+            }
+
+            data->m_TriangulationData.push_back( std::move( poly ) );
+        }
+
+        if( !fis.IsOk() )
+            return corrupt();
+
+        entries.emplace_back( std::move( key ), std::move( data ) );
+    }
+
+    for( auto it = entries.rbegin(); it != entries.rend(); ++it )
+        Put( it->first, std::move( it->second ) );
+
+    m_modified = false;
+
+    wxLogTrace( traceFonts, wxS( "Loaded %zu glyphs from %s" ), entries.size(), aFileName );
+
+    return true;
+}
+
+
+bool GLYPH_CACHE::Save( const wxString& aFileName )
+{
+    if( !m_modified )
+        return true;
+
+    wxFileName fn( aFileName );
+
+    if( !fn.DirExists() && !fn.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        return false;
+
+    // Take a snapshot of the entries so the shards are not locked while writing
+    std::vector<std::pair<GLYPH_CACHE_KEY, std::shared_ptr<const GLYPH_DATA>>> entries;
+    std::vector<std::string>                                                   fontNames;
+
+    for( SHARD& cacheShard : m_shards )
+    {
+        std::lock_guard<std::mutex> lock( cacheShard.m_mutex );
+
+        for( const GLYPH_CACHE_KEY& key : cacheShard.m_lru )
+            entries.emplace_back( key, cacheShard.m_entries.at( key ).m_data );
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( m_fontMutex );
+        fontNames = m_fontNames;
+    }
+
+    // Write a temporary file and rename it, so an interrupted save or another instance writing
+    // at the same time never leaves a partial file behind.
+    wxString tmpFileName = aFileName + wxS( ".tmp" );
+
+    {
+        wxFFileOutputStream fos( tmpFileName );
+
+        if( !fos.IsOk() )
+            return false;
+
+        wxDataOutputStream out( fos );
+
+        out.Write32( GLYPH_CACHE_MAGIC );
+        out.Write32( GLYPH_CACHE_VERSION );
+        out.Write32( entries.size() );
+
+        for( const auto& [ key, dataPtr ] : entries )
+        {
+            const GLYPH_DATA&  data = *dataPtr;
+            const std::string& fontName = fontNames[key.fontId - 1];
+
+            out.Write32( fontName.size() );
+            fos.Write( fontName.data(), fontName.size() );
+            out.Write32( key.codepoint );
+            out.WriteDouble( key.scaler );
+            out.Write8( ( key.fakeItalic ? 1 : 0 ) | ( key.fakeBold ? 2 : 0 )
+                        | ( key.mirror ? 4 : 0 ) );
+            out.WriteDouble( key.angle.AsDegrees() );
+
+            out.Write32( data.m_Contours.size() );
+
+            for( const CONTOUR& contour : data.m_Contours )
+            {
+                out.Write32( contour.m_Winding );
+                out.Write32( contour.m_Orientation );
+                out.Write32( contour.m_Points.size() );
+
+                for( const VECTOR2D& pt : contour.m_Points )
+                {
+                    out.WriteDouble( pt.x );
+                    out.WriteDouble( pt.y );
+                }
+            }
+
+            out.Write32( data.m_TriangulationData.size() );
+
+            for( const std::unique_ptr<SHAPE_POLY_SET::TRIANGULATED_POLYGON>& poly :
+                    data.m_TriangulationData )
+            {
+                out.Write32( poly->GetSourceOutlineIndex() );
+                out.Write32( poly->GetVertexCount() );
+
+                for( const VECTOR2I& pt : poly->Vertices() )
+                {
+                    out.Write32( pt.x );
+                    out.Write32( pt.y );
+                }
+
+                out.Write32( poly->GetTriangleCount() );
+
+                for( const SHAPE_POLY_SET::TRIANGULATED_POLYGON::TRI& tri : poly->Triangles() )
+                {
+                    out.Write32( tri.a );
+                    out.Write32( tri.b );
+                    out.Write32( tri.c );
+                }
+            }
+        }
+
+        if( !fos.IsOk() || !fos.Close() )
+        {
+            wxRemoveFile( tmpFileName );
+            return false;
+        }
+    }
+
+    if( !wxRenameFile( tmpFileName, aFileName, true ) )
+    {
+        wxRemoveFile( tmpFileName );
+        return false;
+    }
+
+    m_modified = false;
+
+    return true;
+}
@@ -29,6 +29,7 @@
 #include <geometry/shape_poly_set.h>
 #include <font/fontconfig.h>
 #include <font/outline_font.h>
+#include <font/glyph_cache.h>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_SFNT_NAMES_H
@@ -37,6 +38,8 @@
 #include FT_BBOX_H
 #include <trigo.h>
 #include <core/utf8.h>
+#include <fmt/format.h>
+#include <wx/filename.h>
 
 using namespace KIFONT;
 
@@ -48,7 +51,8 @@ OUTLINE_FONT::OUTLINE_FONT() :
         m_face(NULL),
         m_faceSize( 16 ),
         m_fakeBold( false ),
-        m_fakeItal( false )
+        m_fakeItal( false ),
+        m_glyphCacheId( 0 )
 {
     std::lock_guard<std::mutex> guard( m_freeTypeMutex );
 
@@ -122,6 +126,17 @@ FT_Error OUTLINE_FONT::loadFace( const wxString& aFontFileName, int aFaceIndex )
 
     if( !e )
     {
+        wxFileName fn( aFontFileName );
+
+        // Identifies the face in the glyph cache; the modification time makes sure glyphs of an
+        // updated font file are not picked up from a persisted cache.
+        std::string fontName = fmt::format( "{}|{}|{}", aFontFileName.ToStdString( wxConvUTF8 ),
+                                            aFaceIndex,
+                                            fn.FileExists() ? fn.GetModificationTime().GetTicks()
+                                                            : 0 );
+
+        m_glyphCacheId = GLYPH_CACHE::GetInstance().GetFontId( fontName );
+
         FT_Select_Charmap( m_face, FT_Encoding::FT_ENCODING_UNICODE );
         // params:
         // m_face = handle to face object
@@ -280,56 +295,8 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphs( BOX2I* aBBox, std::vector<std::unique_pt
                                         const VECTOR2I& aPosition, const EDA_ANGLE& aAngle,
                                         bool aMirror, const VECTOR2I& aOrigin,
                                         TEXT_STYLE_FLAGS aTextStyle ) const
-{
-    std::lock_guard<std::mutex> guard( m_freeTypeMutex );
-
-    return getTextAsGlyphsUnlocked( aBBox, aGlyphs, aText, aSize, aPosition, aAngle, aMirror,
-                                    aOrigin, aTextStyle );
-}
-
-
-struct GLYPH_CACHE_KEY {
-    FT_Face        face;
-    hb_codepoint_t codepoint;
-    double         scaler;
-    bool           fakeItalic;
-    bool           fakeBold;
-    bool           mirror;
-    EDA_ANGLE      angle;
-
-    bool operator==(const GLYPH_CACHE_KEY& rhs ) const
-    {
-        return face == rhs.face && codepoint == rhs.codepoint && scaler == rhs.scaler
-                   && fakeItalic == rhs.fakeItalic && fakeBold == rhs.fakeBold
-                   && mirror == rhs.mirror && angle == rhs.angle;
-    }
-};
-
-namespace std
-{
-    template <>
-    struct hash<GLYPH_CACHE_KEY>
-    {
-        std::size_t operator()( const GLYPH_CACHE_KEY& k ) const
-        {
-            return hash<const void*>()( k.face ) ^ hash<unsigned>()( k.codepoint )
-                        ^ hash<double>()( k.scaler )
-                        ^ hash<int>()( k.fakeItalic ) ^ hash<int>()( k.fakeBold )
-                        ^ hash<int>()( k.mirror ) ^ hash<int>()( k.angle.AsTenthsOfADegree() );
-        }
-    };
-}
-
-
-VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
-                                                std::vector<std::unique_ptr<GLYPH>>* aGlyphs,
-                                                const wxString& aText, const VECTOR2I& aSize,
-                                                const VECTOR2I& aPosition, const EDA_ANGLE& aAngle,
-                                                bool aMirror, const VECTOR2I& aOrigin,
-                                                TEXT_STYLE_FLAGS aTextStyle ) const
 {
     VECTOR2D glyphSize = aSize;
-    FT_Face  face = m_face;
     double   scaler = faceSize();
 
     if( IsSubscript( aTextStyle ) || IsSuperscript( aTextStyle ) )
@@ -337,178 +304,217 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
         scaler = subscriptSize();
     }
 
-    // set glyph resolution so that FT_Load_Glyph() results are good enough for decomposing
-    FT_Set_Char_Size( face, 0, scaler, GLYPH_RESOLUTION, 0 );
+    VECTOR2D scaleFactor( glyphSize.x / faceSize(), -glyphSize.y / faceSize() );
+    scaleFactor = scaleFactor * m_outlineFontSizeCompensation;
 
-    hb_buffer_t* buf = hb_buffer_create();
-    hb_buffer_add_utf8( buf, UTF8( aText ).c_str(), -1, 0, -1 );
-    hb_buffer_guess_segment_properties( buf );  // guess direction, script, and language based on
-                                                // contents
+    // GLYPH_DATA is a collection of all outlines in the glyph; for example the 'o' glyph
+    // generally contains 2 contours, one for the glyph outline and one for the hole
+    GLYPH_CACHE& glyphCache = GLYPH_CACHE::GetInstance();
 
-    hb_font_t* referencedFont = hb_ft_font_create_referenced( face );
-    hb_ft_font_set_funcs( referencedFont );
-    hb_shape( referencedFont, buf, nullptr, 0 );
+    struct PLACED_GLYPH
+    {
+        GLYPH_CACHE_KEY                   m_key;
+        std::shared_ptr<const GLYPH_DATA> m_data;
+        VECTOR2I                          m_cursor;
+    };
 
-    unsigned int         glyphCount;
-    hb_glyph_info_t*     glyphInfo = hb_buffer_get_glyph_infos( buf, &glyphCount );
-    hb_glyph_position_t* glyphPos = hb_buffer_get_glyph_positions( buf, &glyphCount );
+    std::vector<PLACED_GLYPH> placedGlyphs;
+    VECTOR2I                  cursor( 0, 0 );
+    int                       ascender = 0;
+    int                       descender = 0;
 
-    VECTOR2D scaleFactor( glyphSize.x / faceSize(), -glyphSize.y / faceSize() );
-    scaleFactor = scaleFactor * m_outlineFontSizeCompensation;
+    {
+        // FreeType faces (and the HarfBuzz fonts referencing them) are not thread safe.  Only
+        // shaping and decomposing glyphs missing from the cache need the lock; the glyphs are
+        // built from the cached contours afterwards.
+        std::lock_guard<std::mutex> guard( m_freeTypeMutex );
 
-    VECTOR2I cursor( 0, 0 );
+        FT_Face face = m_face;
 
-    if( aGlyphs )
-        aGlyphs->reserve( glyphCount );
+        // set glyph resolution so that FT_Load_Glyph() results are good enough for decomposing
+        FT_Set_Char_Size( face, 0, scaler, GLYPH_RESOLUTION, 0 );
 
-    // GLYPH_DATA is a collection of all outlines in the glyph; for example the 'o' glyph
-    // generally contains 2 contours, one for the glyph outline and one for the hole
-    static std::unordered_map<GLYPH_CACHE_KEY, GLYPH_DATA> s_glyphCache;
+        hb_buffer_t* buf = hb_buffer_create();
+        hb_buffer_add_utf8( buf, UTF8( aText ).c_str(), -1, 0, -1 );
+        hb_buffer_guess_segment_properties( buf );  // guess direction, script, and language based on
+                                                    // contents
 
-    for( unsigned int i = 0; i < glyphCount; i++ )
-    {
-        // Don't process glyphs that were already included in a previous cluster
-        if( i > 0 && glyphInfo[i].cluster == glyphInfo[i-1].cluster )
-            continue;
+        hb_font_t* referencedFont = hb_ft_font_create_referenced( face );
+        hb_ft_font_set_funcs( referencedFont );
+        hb_shape( referencedFont, buf, nullptr, 0 );
+
+        unsigned int         glyphCount;
+        hb_glyph_info_t*     glyphInfo = hb_buffer_get_glyph_infos( buf, &glyphCount );
+        hb_glyph_position_t* glyphPos = hb_buffer_get_glyph_positions( buf, &glyphCount );
 
         if( aGlyphs )
         {
-            GLYPH_CACHE_KEY key = { face, glyphInfo[i].codepoint, scaler, m_fakeItal, m_fakeBold,
-                                    aMirror, aAngle };
-            GLYPH_DATA&     glyphData = s_glyphCache[ key ];
+            aGlyphs->reserve( aGlyphs->size() + glyphCount );
+            placedGlyphs.reserve( glyphCount );
+        }
 
-            if( glyphData.m_Contours.empty() )
+        for( unsigned int i = 0; i < glyphCount; i++ )
+        {
+            // Don't process glyphs that were already included in a previous cluster
+            if( i > 0 && glyphInfo[i].cluster == glyphInfo[i-1].cluster )
+                continue;
+
+            if( aGlyphs )
             {
-                if( m_fakeItal )
+                GLYPH_CACHE_KEY key = { m_glyphCacheId, glyphInfo[i].codepoint, scaler, m_fakeItal,
+                                        m_fakeBold, aMirror, aAngle };
+
+                std::shared_ptr<const GLYPH_DATA> cached = glyphCache.Get( key );
+
+                if( !cached )
                 {
-                    FT_Matrix matrix;
-                    // Create a 12 degree slant
-                    const float angle = (float)( -M_PI * 12.0f ) / 180.0f;
-                    matrix.xx = (FT_Fixed) ( cos( angle ) * 0x10000L );
-                    matrix.xy = (FT_Fixed) ( -sin( angle ) * 0x10000L );
-                    matrix.yx = (FT_Fixed) ( 0 * 0x10000L );  // Don't rotate in the y direction
-                    matrix.yy = (FT_Fixed) ( 1 * 0x10000L );
-
-                    FT_Set_Transform( face, &matrix, nullptr );
-                }
+                    std::shared_ptr<GLYPH_DATA> glyphData = std::make_shared<GLYPH_DATA>();
 
-                FT_Load_Glyph( face, glyphInfo[i].codepoint, FT_LOAD_NO_BITMAP );
+                    if( m_fakeItal )
+                    {
+                        FT_Matrix matrix;
+                        // Create a 12 degree slant
+                        const float angle = (float)( -M_PI * 12.0f ) / 180.0f;
+                        matrix.xx = (FT_Fixed) ( cos( angle ) * 0x10000L );
+                        matrix.xy = (FT_Fixed) ( -sin( angle ) * 0x10000L );
+                        matrix.yx = (FT_Fixed) ( 0 * 0x10000L );  // Don't rotate in the y direction
+                        matrix.yy = (FT_Fixed) ( 1 * 0x10000L );
+
+                        FT_Set_Transform( face, &matrix, nullptr );
+                    }
 
-                if( m_fakeBold )
-                    FT_Outline_Embolden( &face->glyph->outline, 1 << 6 );
+                    FT_Load_Glyph( face, glyphInfo[i].codepoint, FT_LOAD_NO_BITMAP );
 
-                OUTLINE_DECOMPOSER decomposer( face->glyph->outline );
+                    if( m_fakeBold )
+                        FT_Outline_Embolden( &face->glyph->outline, 1 << 6 );
 
-                if( !decomposer.OutlineToSegments( &glyphData.m_Contours ) )
-                {
-                    double  hb_advance = glyphPos[i].x_advance * GLYPH_SIZE_SCALER;
-                    BOX2D   tofuBox( { scaler * 0.03, 0.0 },
-                                     { hb_advance - scaler * 0.02, scaler * 0.72 } );
-
-                    glyphData.m_Contours.clear();
-
-                    CONTOUR outline;
-                    outline.m_Winding = 1;
-                    outline.m_Orientation = FT_ORIENTATION_TRUETYPE;
-                    outline.m_Points.push_back( tofuBox.GetPosition() );
-                    outline.m_Points.push_back( { tofuBox.GetSize().x, tofuBox.GetPosition().y } );
-                    outline.m_Points.push_back( tofuBox.GetSize() );
-                    outline.m_Points.push_back( { tofuBox.GetPosition().x, tofuBox.GetSize().y } );
-                    glyphData.m_Contours.push_back( outline );
-
-                    CONTOUR hole;
-                    tofuBox.Move( { scaler * 0.06, scaler * 0.06 } );
-                    tofuBox.SetSize( { tofuBox.GetWidth() - scaler * 0.06,
-                                       tofuBox.GetHeight() - scaler * 0.06 } );
-                    hole.m_Winding = 1;
-                    hole.m_Orientation = FT_ORIENTATION_NONE;
-                    hole.m_Points.push_back( tofuBox.GetPosition() );
-                    hole.m_Points.push_back( { tofuBox.GetSize().x, tofuBox.GetPosition().y } );
-                    hole.m_Points.push_back( tofuBox.GetSize() );
-                    hole.m_Points.push_back( { tofuBox.GetPosition().x, tofuBox.GetSize().y } );
-                    glyphData.m_Contours.push_back( hole );
+                    OUTLINE_DECOMPOSER decomposer( face->glyph->outline );
+
+                    if( !decomposer.OutlineToSegments( &glyphData->m_Contours ) )
+                    {
+                        double  hb_advance = glyphPos[i].x_advance * GLYPH_SIZE_SCALER;
+                        BOX2D   tofuBox( { scaler * 0.03, 0.0 },
+                                         { hb_advance - scaler * 0.02, scaler * 0.72 } );
+
+                        glyphData->m_Contours.clear();
+
+                        CONTOUR outline;
+                        outline.m_Winding = 1;
+                        outline.m_Orientation = FT_ORIENTATION_TRUETYPE;
+                        outline.m_Points.push_back( tofuBox.GetPosition() );
+                        outline.m_Points.push_back( { tofuBox.GetSize().x, tofuBox.GetPosition().y } );
+                        outline.m_Points.push_back( tofuBox.GetSize() );
+                        outline.m_Points.push_back( { tofuBox.GetPosition().x, tofuBox.GetSize().y } );
+                        glyphData->m_Contours.push_back( outline );
+
+                        CONTOUR hole;
+                        tofuBox.Move( { scaler * 0.06, scaler * 0.06 } );
+                        tofuBox.SetSize( { tofuBox.GetWidth() - scaler * 0.06,
+                                           tofuBox.GetHeight() - scaler * 0.06 } );
+                        hole.m_Winding = 1;
+                        hole.m_Orientation = FT_ORIENTATION_NONE;
+                        hole.m_Points.push_back( tofuBox.GetPosition() );
+                        hole.m_Points.push_back( { tofuBox.GetSize().x, tofuBox.GetPosition().y } );
+                        hole.m_Points.push_back( tofuBox.GetSize() );
+                        hole.m_Points.push_back( { tofuBox.GetPosition().x, tofuBox.GetSize().y } );
+                        glyphData->m_Contours.push_back( hole );
+                    }
+
+                    glyphCache.Put( key, glyphData );
+                    cached = glyphData;
                 }
+
+                placedGlyphs.push_back( { std::move( key ), std::move( cached ), cursor } );
             }
 
-            std::unique_ptr<OUTLINE_GLYPH> glyph = std::make_unique<OUTLINE_GLYPH>();
-            std::vector<SHAPE_LINE_CHAIN>  holes;
+            hb_glyph_position_t& pos = glyphPos[i];
+            cursor.x += ( pos.x_advance * GLYPH_SIZE_SCALER );
+            cursor.y += ( pos.y_advance * GLYPH_SIZE_SCALER );
+        }
 
-            for( CONTOUR& c : glyphData.m_Contours )
-            {
-                std::vector<VECTOR2D> points = c.m_Points;
-                SHAPE_LINE_CHAIN      shape;
+        ascender = abs( face->size->metrics.ascender * GLYPH_SIZE_SCALER );
+        descender = abs( face->size->metrics.descender * GLYPH_SIZE_SCALER );
 
-                shape.ReservePoints( points.size() );
+        hb_buffer_destroy( buf );
+        hb_font_destroy( referencedFont );
+    }
 
-                for( const VECTOR2D& v : points )
-                {
-                    VECTOR2D pt( v + cursor );
+    for( PLACED_GLYPH& placed : placedGlyphs )
+    {
+        std::unique_ptr<OUTLINE_GLYPH> glyph = std::make_unique<OUTLINE_GLYPH>();
+        std::vector<SHAPE_LINE_CHAIN>  holes;
 
-                    if( IsSubscript( aTextStyle ) )
-                        pt.y += m_subscriptVerticalOffset * scaler;
-                    else if( IsSuperscript( aTextStyle ) )
-                        pt.y += m_superscriptVerticalOffset * scaler;
+        for( const CONTOUR& c : placed.m_data->m_Contours )
+        {
+            SHAPE_LINE_CHAIN shape;
 
-                    pt *= scaleFactor;
-                    pt += aPosition;
+            shape.ReservePoints( c.m_Points.size() );
 
-                    if( aMirror )
-                        pt.x = aOrigin.x - ( pt.x - aOrigin.x );
+            for( const VECTOR2D& v : c.m_Points )
+            {
+                VECTOR2D pt( v + placed.m_cursor );
 
-                    if( !aAngle.IsZero() )
-                        RotatePoint( pt, aOrigin, aAngle );
+                if( IsSubscript( aTextStyle ) )
+                    pt.y += m_subscriptVerticalOffset * scaler;
+                else if( IsSuperscript( aTextStyle ) )
+                    pt.y += m_superscriptVerticalOffset * scaler;
 
-                    shape.Append( pt.x, pt.y );
-                }
+                pt *= scaleFactor;
+                pt += aPosition;
 
-                shape.SetClosed( true );
+                if( aMirror )
+                    pt.x = aOrigin.x - ( pt.x - aOrigin.x );
 
-                if( contourIsHole( c ) )
-                    holes.push_back( std::move( shape ) );
-                else
-                    glyph->AddOutline( std::move( shape ) );
+                if( !aAngle.IsZero() )
+                    RotatePoint( pt, aOrigin, aAngle );
+
+                shape.Append( pt.x, pt.y );
             }
 
-            for( SHAPE_LINE_CHAIN& hole : holes )
+            shape.SetClosed( true );
+
+            if( contourIsHole( c ) )
+                holes.push_back( std::move( shape ) );
+            else
+                glyph->AddOutline( std::move( shape ) );
+        }
+
+        for( SHAPE_LINE_CHAIN& hole : holes )
+        {
+            if( hole.PointCount() )
             {
-                if( hole.PointCount() )
+                for( int ii = 0; ii < glyph->OutlineCount(); ++ii )
                 {
-                    for( int ii = 0; ii < glyph->OutlineCount(); ++ii )
+                    if( glyph->Outline( ii ).PointInside( hole.GetPoint( 0 ) ) )
                     {
-                        if( glyph->Outline( ii ).PointInside( hole.GetPoint( 0 ) ) )
-                        {
-                            glyph->AddHole( std::move( hole ), ii );
-                            break;
-                        }
+                        glyph->AddHole( std::move( hole ), ii );
+                        break;
                     }
                 }
             }
+        }
 
-            if( glyphData.m_TriangulationData.empty() )
-            {
-                glyph->CacheTriangulation( false, false );
-                glyphData.m_TriangulationData = glyph->GetTriangulationData();
-            }
-            else
-            {
-                glyph->CacheTriangulation( glyphData.m_TriangulationData );
-            }
-
-            aGlyphs->push_back( std::move( glyph ) );
+        if( placed.m_data->m_TriangulationData.empty() )
+        {
+            glyph->CacheTriangulation( false, false );
+
+            // Cache entries are shared between threads and never modified, so store a new
+            // entry carrying the triangulation hint.
+            std::shared_ptr<GLYPH_DATA> glyphData = std::make_shared<GLYPH_DATA>();
+            glyphData->m_Contours = placed.m_data->m_Contours;
+            glyphData->m_TriangulationData = glyph->GetTriangulationData();
+            glyphCache.Put( placed.m_key, glyphData );
+        }
+        else
+        {
+            // The hint data is only read
+            glyph->CacheTriangulation( const_cast<GLYPH_DATA&>( *placed.m_data ).m_TriangulationData );
         }
 
-        hb_glyph_position_t& pos = glyphPos[i];
-        cursor.x += ( pos.x_advance * GLYPH_SIZE_SCALER );
-        cursor.y += ( pos.y_advance * GLYPH_SIZE_SCALER );
+        aGlyphs->push_back( std::move( glyph ) );
     }
 
-    int      ascender = abs( face->size->metrics.ascender * GLYPH_SIZE_SCALER );
-    int      descender = abs( face->size->metrics.descender * GLYPH_SIZE_SCALER );
     VECTOR2I extents( cursor.x * scaleFactor.x, ( ascender + descender ) * abs( scaleFactor.y ) );
-
-    hb_buffer_destroy( buf );
-    hb_font_destroy( referencedFont );
-
     VECTOR2I cursorDisplacement( cursor.x * scaleFactor.x, -cursor.y * scaleFactor.y );
 
     if( aBBox )
@@ -0,0 +1,214 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <font/stroke_text_cache.h>
+
+#include <callback_gal.h>
+#include <convert_basic_shapes_to_polygon.h>
+#include <font/font.h>
+#include <hash.h>
+#include <trigo.h>
+
+using namespace KIFONT;
+
+
+/// Each cache is emptied when it grows past this number of texts.  Boards rarely have more
+/// distinct reference designators, values and labels than this.
+static const size_t MAX_CACHED_TEXTS = 20000;
+
+
+bool STROKE_TEXT_CACHE::KEY::operator==( const KEY& aRhs ) const
+{
+    return m_font == aRhs.m_font
+            && m_maxError == aRhs.m_maxError
+            && m_errorLoc == aRhs.m_errorLoc
+            && m_interlinePitch == aRhs.m_interlinePitch
+            && m_overbarHeight == aRhs.m_overbarHeight
+            && m_underlineOffset == aRhs.m_underlineOffset
+            && m_text == aRhs.m_text
+            && m_attrs == aRhs.m_attrs;
+}
+
+
+std::size_t STROKE_TEXT_CACHE::KEY_HASH::operator()( const KEY& aKey ) const
+{
+    return hash_val( aKey.m_font, aKey.m_text, aKey.m_attrs, aKey.m_interlinePitch,
+                     aKey.m_overbarHeight, aKey.m_underlineOffset, aKey.m_maxError,
+                     static_cast<int>( aKey.m_errorLoc ) );
+}
+
+
+STROKE_TEXT_CACHE& STROKE_TEXT_CACHE::GetInstance()
+{
+    static STROKE_TEXT_CACHE s_instance;
+    return s_instance;
+}
+
+
+STROKE_TEXT_CACHE::KEY STROKE_TEXT_CACHE::makeKey( const FONT* aFont, const wxString& aText,
+                                                   const TEXT_ATTRIBUTES& aAttrs,
+                                                   const METRICS& aFontMetrics, int aMaxError,
+                                                   ERROR_LOC aErrorLoc )
+{
+    KEY key{ aFont, aText, aAttrs, aFontMetrics.m_InterlinePitch, aFontMetrics.m_OverbarHeight,
+             aFontMetrics.m_UnderlineOffset, aMaxError, aErrorLoc };
+
+    // Normalise the attributes which don't change the shape (or are applied afterwards)
+    key.m_attrs.m_Angle = ANGLE_0;
+    key.m_attrs.m_Color = KIGFX::COLOR4D::UNSPECIFIED;
+    key.m_attrs.m_Visible = true;
+    key.m_attrs.m_KeepUpright = false;
+
+    return key;
+}
+
+
+std::shared_ptr<const std::vector<SEG>> STROKE_TEXT_CACHE::getStrokes( const KEY& aKey,
+                                                                      const METRICS& aFontMetrics )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_strokes.find( aKey );
+
+        if( it != m_strokes.end() )
+            return it->second;
+    }
+
+    // Expand the glyphs outside of the lock; two threads may occasionally both build the same
+    // text, which is harmless.
+    KIGFX::GAL_DISPLAY_OPTIONS        empty_opts;
+    std::shared_ptr<std::vector<SEG>> strokes = std::make_shared<std::vector<SEG>>();
+
+    CALLBACK_GAL callback_gal( empty_opts,
+            // Stroke callback
+            [&]( const VECTOR2I& aPt1, const VECTOR2I& aPt2 )
+            {
+                strokes->emplace_back( aPt1, aPt2 );
+            },
+            // Triangulation callback (not used by stroke fonts)
+            []( const VECTOR2I&, const VECTOR2I&, const VECTOR2I& )
+            {
+            } );
+
+    aKey.m_font->Draw( &callback_gal, aKey.m_text, VECTOR2I( 0, 0 ), aKey.m_attrs, aFontMetrics );
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( m_strokes.size() >= MAX_CACHED_TEXTS )
+        m_strokes.clear();
+
+    m_strokes[aKey] = strokes;
+
+    return strokes;
+}
+
+
+std::vector<SEG> STROKE_TEXT_CACHE::GetStrokes( const FONT* aFont, const wxString& aText,
+                                                const VECTOR2I& aPosition,
+                                                const TEXT_ATTRIBUTES& aAttrs,
+                                                const METRICS& aFontMetrics )
+{
+    KEY key = makeKey( aFont, aText, aAttrs, aFontMetrics, -1, ERROR_INSIDE );
+
+    std::shared_ptr<const std::vector<SEG>> cached = getStrokes( key, aFontMetrics );
+    std::vector<SEG>                        strokes( *cached );
+
+    for( SEG& seg : strokes )
+    {
+        if( !aAttrs.m_Angle.IsZero() )
+        {
+            RotatePoint( seg.A, aAttrs.m_Angle );
+            RotatePoint( seg.B, aAttrs.m_Angle );
+        }
+
+        seg.A += aPosition;
+        seg.B += aPosition;
+    }
+
+    return strokes;
+}
+
+
+void STROKE_TEXT_CACHE::TransformTextToPolySet( SHAPE_POLY_SET& aBuffer, const FONT* aFont,
+                                                const wxString& aText, const VECTOR2I& aPosition,
+                                                const TEXT_ATTRIBUTES& aAttrs,
+                                                const METRICS& aFontMetrics, int aMaxError,
+                                                ERROR_LOC aErrorLoc )
+{
+    KEY                                   key = makeKey( aFont, aText, aAttrs, aFontMetrics,
+                                                         aMaxError, aErrorLoc );
+    std::shared_ptr<const SHAPE_POLY_SET> cached;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_polys.find( key );
+
+        if( it != m_polys.end() )
+            cached = it->second;
+    }
+
+    if( !cached )
+    {
+        KEY strokesKey = key;
+        strokesKey.m_maxError = -1;
+        strokesKey.m_errorLoc = ERROR_INSIDE;
+
+        std::shared_ptr<SHAPE_POLY_SET> poly = std::make_shared<SHAPE_POLY_SET>();
+        int                             penWidth = aAttrs.m_StrokeWidth;
+
+        for( const SEG& seg : *getStrokes( strokesKey, aFontMetrics ) )
+            TransformOvalToPolygon( *poly, seg.A, seg.B, penWidth, aMaxError, aErrorLoc );
+
+        // Combining the strokes gives a shape with a lot less vertices, which speeds up any
+        // further calculation a lot.
+        poly->Simplify( SHAPE_POLY_SET::PM_FAST );
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        if( m_polys.size() >= MAX_CACHED_TEXTS )
+            m_polys.clear();
+
+        m_polys[key] = poly;
+        cached = poly;
+    }
+
+    SHAPE_POLY_SET textShape( *cached );
+
+    if( !aAttrs.m_Angle.IsZero() )
+        textShape.Rotate( aAttrs.m_Angle );
+
+    textShape.Move( aPosition );
+
+    aBuffer.Append( textShape );
+}
+
+
+void STROKE_TEXT_CACHE::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_strokes.clear();
+    m_polys.clear();
+}
@@ -35,6 +35,7 @@ JOB_EXPORT_PCB_GERBER::JOB_EXPORT_PCB_GERBER( const std::string& aType, bool aIs
     m_disableApertureMacros( false ),
     m_useAuxOrigin( false ),
     m_useProtelFileExtension( true ),
+    m_mergeCopper( false ),
     m_precision( 5 ),
     m_printMaskLayer()
 {
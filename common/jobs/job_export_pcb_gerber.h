@@ -46,6 +46,7 @@ public:
     bool m_disableApertureMacros;
     bool m_useAuxOrigin;
     bool m_useProtelFileExtension;
+    bool m_mergeCopper;         ///< Plot tracks and zones of each net as merged regions
 
     int m_precision;
 
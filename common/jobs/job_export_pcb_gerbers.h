@@ -37,6 +37,9 @@ public:
 
     bool m_layersIncludeOnAllSet;
     bool m_useBoardPlotParams;
+
+    /// Plot the layers concurrently, each one to its own file
+    bool m_parallel;
 };
 
 #endif
\ No newline at end of file
@@ -34,6 +34,7 @@ JOB_EXPORT_PCB_SVG::JOB_EXPORT_PCB_SVG( bool aIsCli ) :
     m_pageSizeMode( 0 ),
     m_printMaskLayer(),
     m_sketchPadsOnFabLayers( false ),
-    m_drillShapeOption( 2 )
+    m_drillShapeOption( 2 ),
+    m_useSymbols( false )
 {
 }
\ No newline at end of file
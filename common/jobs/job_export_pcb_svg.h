@@ -50,6 +50,9 @@ public:
     // How holes in pads/vias are plotted:
     // 0 = no hole, 1 = small shape, 2 = actual shape
     int m_drillShapeOption;
+
+    ///< Emit repeated pad shapes once as SVG symbols
+    bool m_useSymbols;
 };
 
 #endif
\ No newline at end of file
@@ -26,6 +26,9 @@ JOB_EXPORT_SCH_BOM::JOB_EXPORT_SCH_BOM( bool aIsCli ) :
     m_filename(),
     m_outputFile(),
 
+    m_bomPresetNames(),
+    m_bomFmtPresetNames(),
+
     m_fieldDelimiter(),
     m_stringDelimiter(),
     m_refDelimiter(),
@@ -39,6 +39,10 @@ public:
     wxString m_bomPresetName;
     wxString m_bomFmtPresetName;
 
+    // Batch options: every preset is exported with every format preset, each to its own file
+    std::vector<wxString> m_bomPresetNames;
+    std::vector<wxString> m_bomFmtPresetNames;
+
     // Format options
     wxString m_fieldDelimiter;
     wxString m_stringDelimiter;
@@ -50,6 +50,7 @@
 #include <common.h>
 #include <confirm.h>
 #include <core/arraydim.h>
+#include <font/glyph_cache.h>
 #include <id.h>
 #include <kicad_curl/kicad_curl.h>
 #include <kiplatform/policy.h>
@@ -170,6 +171,11 @@ void PGM_BASE::Destroy()
 {
     KICAD_CURL::Cleanup();
 
+    // Headless runs (kicad-cli, unit tests) only use a few glyphs and may run concurrently;
+    // leave the cache file to the interactive sessions.
+    if( !m_glyphCacheFile.IsEmpty() && IsGUI() )
+        KIFONT::GLYPH_CACHE::GetInstance().Save( m_glyphCacheFile );
+
 #ifdef KICAD_USE_SENTRY
     sentry_close();
 #endif
@@ -607,6 +613,15 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
 
     GetNotificationsManager().Load();
 
+    // Reuse the outline font glyphs decomposed in previous sessions.  Like the save in
+    // Destroy(), this is only done for interactive sessions: the cache file is left empty for
+    // the others, which also skips the save.
+    if( !aIsUnitTest && IsGUI() )
+    {
+        m_glyphCacheFile = KIFONT::GLYPH_CACHE::GetDefaultCacheFile();
+        KIFONT::GLYPH_CACHE::GetInstance().Load( m_glyphCacheFile );
+    }
+
     // Create the python scripting stuff
     // Skip it fot applications that do not use it
     if( !aSkipPyInit )
@@ -37,6 +37,7 @@
 #include <plotters/gbr_plotter_aperture_macros.h>
 
 #include <gbr_metadata.h>
+#include <hash.h>
 
 
 // if GBR_USE_MACROS is defined, pads having a shape that is not a Gerber primitive
@@ -69,6 +70,8 @@
 // number of vertices and each vertex coordinate are similar, i.e. if the difference
 // between coordinates is small ( <= margin to accept rounding issues coming from polygon
 // geometric transforms like rotation
+static const int POLY_COMPARE_MARGIN = 2;
+
 static bool polyCompare( const std::vector<VECTOR2I>& aPolygon,
                          const std::vector<VECTOR2I>& aTestPolygon )
 {
@@ -76,7 +79,7 @@ static bool polyCompare( const std::vector<VECTOR2I>& aPolygon,
     if( aTestPolygon.size() != aPolygon.size() )
         return false;
 
-    const int margin = 2;
+    const int margin = POLY_COMPARE_MARGIN;
 
     for( size_t jj = 0; jj < aPolygon.size(); jj++ )
     {
@@ -89,6 +92,69 @@ static bool polyCompare( const std::vector<VECTOR2I>& aPolygon,
 }
 
 
+// Grid used to key corner lists in aperture dictionaries.  It must be coarser than the
+// polyCompare() margin so that similar polygons have their first corner in the same or in a
+// neighbouring cell.
+static const int POLY_KEY_GRID = 16;
+
+static_assert( POLY_KEY_GRID > 2 * POLY_COMPARE_MARGIN );
+
+
+static VECTOR2I polyKeyCell( const std::vector<VECTOR2I>& aPolygon )
+{
+    if( aPolygon.empty() )
+        return VECTOR2I( 0, 0 );
+
+    auto cell =
+            []( int aCoord )
+            {
+                // Round towards negative infinity
+                return aCoord >= 0 ? aCoord / POLY_KEY_GRID : ( aCoord + 1 ) / POLY_KEY_GRID - 1;
+            };
+
+    return VECTOR2I( cell( aPolygon[0].x ), cell( aPolygon[0].y ) );
+}
+
+
+// Return the lowest index stored in aIndex for a polygon similar to aPolygon (as
+// checked by aIsSame), or -1.  aKey holds the key fields which are not related to the polygon.
+template <typename IS_SAME>
+static int findPolyInIndex( const APERTURE_POLY_INDEX& aIndex, APERTURE_KEY aKey,
+                            const std::vector<VECTOR2I>& aPolygon, IS_SAME aIsSame )
+{
+    VECTOR2I cell = polyKeyCell( aPolygon );
+    int      found = -1;
+
+    aKey.m_CornerCount = (int) aPolygon.size();
+
+    for( int dx = -1; dx <= 1; ++dx )
+    {
+        for( int dy = -1; dy <= 1; ++dy )
+        {
+            aKey.m_FirstCornerCell = cell + VECTOR2I( dx, dy );
+
+            auto range = aIndex.equal_range( aKey );
+
+            for( auto it = range.first; it != range.second; ++it )
+            {
+                if( ( found < 0 || it->second < found ) && aIsSame( it->second ) )
+                    found = it->second;
+            }
+        }
+    }
+
+    return found;
+}
+
+
+std::size_t APERTURE_KEY_HASH::operator()( const APERTURE_KEY& aKey ) const
+{
+    return hash_val( aKey.m_Type, aKey.m_Size.x, aKey.m_Size.y, aKey.m_Radius,
+                     aKey.m_Rotation.AsDegrees(), aKey.m_ApertureAttribute, aKey.m_CornerCount,
+                     aKey.m_FirstCornerCell.x, aKey.m_FirstCornerCell.y );
+}
+
+
 GERBER_PLOTTER::GERBER_PLOTTER()
 {
     workFile  = nullptr;
@@ -416,19 +482,18 @@ int GERBER_PLOTTER::GetOrCreateAperture( const VECTOR2I& aSize, int aRadius,
                                          const EDA_ANGLE& aRotation, APERTURE::APERTURE_TYPE aType,
                                          int aApertureAttribute )
 {
-    int last_D_code = 9;
+    APERTURE_KEY key;
+    key.m_Type = aType;
+    key.m_Size = aSize;
+    key.m_Radius = aRadius;
+    key.m_Rotation = aRotation;
+    key.m_ApertureAttribute = aApertureAttribute;
 
     // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
-    {
-        APERTURE* tool = &m_apertures[idx];
-        last_D_code = tool->m_DCode;
+    auto it = m_apertureIndex.find( key );
 
-        if( (tool->m_Type == aType) && (tool->m_Size == aSize) &&
-            (tool->m_Radius == aRadius) && (tool->m_Rotation == aRotation) &&
-            (tool->m_ApertureAttribute == aApertureAttribute) )
-            return idx;
-    }
+    if( it != m_apertureIndex.end() )
+        return it->second;
 
     // Allocate a new aperture
     APERTURE new_tool;
@@ -436,12 +501,16 @@ int GERBER_PLOTTER::GetOrCreateAperture( const VECTOR2I& aSize, int aRadius,
     new_tool.m_Type     = aType;
     new_tool.m_Radius   = aRadius;
     new_tool.m_Rotation = aRotation;
-    new_tool.m_DCode    = last_D_code + 1;
+    new_tool.m_DCode    = m_apertures.empty() ? FIRST_DCODE_VALUE
+                                              : m_apertures.back().m_DCode + 1;
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
     m_apertures.push_back( new_tool );
 
-    return m_apertures.size() - 1;
+    int idx = (int) m_apertures.size() - 1;
+    m_apertureIndex[key] = idx;
+
+    return idx;
 }
 
 
@@ -449,8 +518,6 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
                                          const EDA_ANGLE& aRotation, APERTURE::APERTURE_TYPE aType,
                                          int aApertureAttribute )
 {
-    int last_D_code = 9;
-
     // For APERTURE::AM_FREE_POLYGON aperture macros, we need to create the macro
     // on the fly, because due to the fact the vertex count is not a constant we
     // cannot create a static definition.
@@ -462,25 +529,20 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
             m_am_freepoly_list.Append( aCorners );
     }
 
-    // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
-    {
-        APERTURE* tool = &m_apertures[idx];
+    APERTURE_KEY key;
+    key.m_Type = aType;
+    key.m_Rotation = aRotation;
+    key.m_ApertureAttribute = aApertureAttribute;
 
-       last_D_code = tool->m_DCode;
+    // Search an existing aperture.  The corner lists must be similar
+    int found = findPolyInIndex( m_polyApertureIndex, key, aCorners,
+                                 [&]( int aIdx )
+                                 {
+                                     return polyCompare( m_apertures[aIdx].m_Corners, aCorners );
+                                 } );
 
-        if( (tool->m_Type == aType) &&
-            (tool->m_Corners.size() == aCorners.size() ) &&
-            (tool->m_Rotation == aRotation) &&
-            (tool->m_ApertureAttribute == aApertureAttribute) )
-        {
-            // A candidate is found. the corner lists must be similar
-            bool is_same = polyCompare( tool->m_Corners, aCorners );
-
-            if( is_same )
-                return idx;
-        }
-    }
+    if( found >= 0 )
+        return found;
 
     // Allocate a new aperture
     APERTURE new_tool;
@@ -490,12 +552,19 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
     new_tool.m_Type     = aType;
     new_tool.m_Radius   = 0;             // Not used
     new_tool.m_Rotation = aRotation;
-    new_tool.m_DCode    = last_D_code + 1;
+    new_tool.m_DCode    = m_apertures.empty() ? FIRST_DCODE_VALUE
+                                              : m_apertures.back().m_DCode + 1;
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
     m_apertures.push_back( new_tool );
 
-    return m_apertures.size() - 1;
+    int idx = (int) m_apertures.size() - 1;
+
+    key.m_CornerCount = (int) aCorners.size();
+    key.m_FirstCornerCell = polyKeyCell( aCorners );
+    m_polyApertureIndex.emplace( key, idx );
+
+    return idx;
 }
 
 
@@ -2061,17 +2130,20 @@ void APER_MACRO_FREEPOLY_LIST::Format( FILE * aOutput, double aIu2GbrMacroUnit )
 
 void APER_MACRO_FREEPOLY_LIST::Append( const std::vector<VECTOR2I>& aPolygon )
 {
+    APERTURE_KEY key;
+    key.m_CornerCount = (int) aPolygon.size();
+    key.m_FirstCornerCell = polyKeyCell( aPolygon );
+
+    m_index.emplace( key, AmCount() );
     m_AMList.emplace_back( aPolygon, AmCount() );
 }
 
 
 int APER_MACRO_FREEPOLY_LIST::FindAm( const std::vector<VECTOR2I>& aPolygon ) const
 {
-    for( int idx = 0; idx < AmCount(); idx++ )
-    {
-        if( m_AMList[idx].IsSamePoly( aPolygon ) )
-            return idx;
-    }
-
-    return -1;
+    return findPolyInIndex( m_index, APERTURE_KEY(), aPolygon,
+                            [&]( int aIdx )
+                            {
+                                return m_AMList[aIdx].IsSamePoly( aPolygon );
+                            } );
 }
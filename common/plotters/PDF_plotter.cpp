@@ -40,7 +40,7 @@
 #include <advanced_config.h>
 #include <eda_text.h> // for IsGotoPageHref
 #include <font/font.h>
-#include <core/ignore.h>
+#include <geometry/shape_poly_set.h>
 #include <macros.h>
 #include <trigo.h>
 #include <string_utils.h>
@@ -114,6 +114,76 @@ std::string PDF_PLOTTER::encodeStringForPlotter( const wxString& aText )
 }
 
 
+/// Amount of stream content collected before it is passed on to zlib
+static const size_t PDF_STREAM_CHUNK_SIZE = 64 * 1024;
+
+
+PDF_STREAM_FORMATTER::PDF_STREAM_FORMATTER( bool aCompress ) :
+        m_memStream( std::make_unique<wxMemoryOutputStream>() )
+{
+    /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
+     * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
+     * stream! (a DEFLATE stream would be generated with -15 instead of 15)
+     * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
+     *                    8, Z_DEFAULT_STRATEGY );
+     */
+    if( aCompress )
+    {
+        m_zlibStream = std::make_unique<wxZlibOutputStream>( *m_memStream, wxZ_BEST_COMPRESSION,
+                                                             wxZLIB_ZLIB );
+    }
+
+    m_pending.reserve( PDF_STREAM_CHUNK_SIZE );
+}
+
+
+PDF_STREAM_FORMATTER::~PDF_STREAM_FORMATTER()
+{
+    // The zlib stream writes to the memory stream, so it must go first
+    m_zlibStream.reset();
+}
+
+
+void PDF_STREAM_FORMATTER::write( const char* aOutBuf, int aCount )
+{
+    m_pending.append( aOutBuf, aCount );
+
+    if( m_pending.size() >= PDF_STREAM_CHUNK_SIZE )
+        flushPending();
+}
+
+
+void PDF_STREAM_FORMATTER::flushPending()
+{
+    if( m_pending.empty() )
+        return;
+
+    if( m_zlibStream )
+        m_zlibStream->Write( m_pending.data(), m_pending.size() );
+    else
+        m_memStream->Write( m_pending.data(), m_pending.size() );
+
+    m_pending.clear();
+}
+
+
+size_t PDF_STREAM_FORMATTER::WriteTo( FILE* aFile )
+{
+    flushPending();
+
+    // Flush the remaining compressed data
+    if( m_zlibStream )
+        m_zlibStream->Close();
+
+    wxStreamBuffer* sb = m_memStream->GetOutputStreamBuffer();
+    size_t          count = sb->Tell();
+
+    fwrite( sb->GetBufferStart(), 1, count, aFile );
+
+    return count;
+}
+
+
 bool PDF_PLOTTER::OpenFile( const wxString& aFullFilename )
 {
     m_filename = aFullFilename;
@@ -161,7 +231,7 @@ void PDF_PLOTTER::SetCurrentLineWidth( int aWidth, void* aData )
     wxASSERT_MSG( aWidth > 0, "Plotter called to set negative pen width" );
 
     if( aWidth != m_currentPenWidth )
-        fprintf( m_workFile, "%g w\n", userToDeviceSize( aWidth ) );
+        m_workFile->Print( 0, "%g w\n", userToDeviceSize( aWidth ) );
 
     m_currentPenWidth = aWidth;
 }
@@ -171,6 +241,10 @@ void PDF_PLOTTER::emitSetRGBColor( double r, double g, double b, double a )
 {
     wxASSERT( m_workFile );
 
+    // Forms are drawn with the color of the page where they are used
+    if( m_capturingForm )
+        return;
+
     // PDF treats all colors as opaque, so the best we can do with alpha is generate an
     // appropriate blended color assuming white paper.
     if( a < 1.0 )
@@ -180,7 +254,7 @@ void PDF_PLOTTER::emitSetRGBColor( double r, double g, double b, double a )
         b = ( b * a ) + ( 1 - a );
     }
 
-    fprintf( m_workFile, "%g %g %g rg %g %g %g RG\n", r, g, b, r, g, b );
+    m_workFile->Print( 0, "%g %g %g rg %g %g %g RG\n", r, g, b, r, g, b );
 }
 
 
@@ -191,30 +265,30 @@ void PDF_PLOTTER::SetDash( int aLineWidth, LINE_STYLE aLineStyle )
     switch( aLineStyle )
     {
     case LINE_STYLE::DASH:
-        fprintf( m_workFile, "[%d %d] 0 d\n",
+        m_workFile->Print( 0, "[%d %d] 0 d\n",
                 (int) GetDashMarkLenIU( aLineWidth ), (int) GetDashGapLenIU( aLineWidth ) );
         break;
 
     case LINE_STYLE::DOT:
-        fprintf( m_workFile, "[%d %d] 0 d\n",
+        m_workFile->Print( 0, "[%d %d] 0 d\n",
                 (int) GetDotMarkLenIU( aLineWidth ), (int) GetDashGapLenIU( aLineWidth ) );
         break;
 
     case LINE_STYLE::DASHDOT:
-        fprintf( m_workFile, "[%d %d %d %d] 0 d\n",
+        m_workFile->Print( 0, "[%d %d %d %d] 0 d\n",
                 (int) GetDashMarkLenIU( aLineWidth ), (int) GetDashGapLenIU( aLineWidth ),
                 (int) GetDotMarkLenIU( aLineWidth ), (int) GetDashGapLenIU( aLineWidth ) );
         break;
 
     case LINE_STYLE::DASHDOTDOT:
-        fprintf( m_workFile, "[%d %d %d %d %d %d] 0 d\n",
+        m_workFile->Print( 0, "[%d %d %d %d %d %d] 0 d\n",
                 (int) GetDashMarkLenIU( aLineWidth ), (int) GetDashGapLenIU( aLineWidth ),
                 (int) GetDotMarkLenIU( aLineWidth ), (int) GetDashGapLenIU( aLineWidth ),
                 (int) GetDotMarkLenIU( aLineWidth ), (int) GetDashGapLenIU( aLineWidth ) );
         break;
 
     default:
-        fputs( "[] 0 d\n", m_workFile );
+        m_workFile->Print( 0, "[] 0 d\n" );
     }
 }
 
@@ -265,8 +339,8 @@ void PDF_PLOTTER::Rect( const VECTOR2I& p1, const VECTOR2I& p2, FILL_T fill, int
     else
         paintOp = width > 0 ? 'B' : 'f';
 
-    fprintf( m_workFile, "%g %g %g %g re %c\n", p1_dev.x, p1_dev.y, p2_dev.x - p1_dev.x,
-             p2_dev.y - p1_dev.y, paintOp );
+    m_workFile->Print( 0, "%g %g %g %g re %c\n", p1_dev.x, p1_dev.y, p2_dev.x - p1_dev.x,
+                       p2_dev.y - p1_dev.y, paintOp );
 }
 
 
@@ -300,31 +374,31 @@ void PDF_PLOTTER::Circle( const VECTOR2I& pos, int diametre, FILL_T aFill, int w
     double magic = radius * 0.551784; // You don't want to know where this come from
 
     // This is the convex hull for the bezier approximated circle
-    fprintf( m_workFile,
-             "%g %g m "
-             "%g %g %g %g %g %g c "
-             "%g %g %g %g %g %g c "
-             "%g %g %g %g %g %g c "
-             "%g %g %g %g %g %g c %c\n",
-             pos_dev.x - radius, pos_dev.y,
-
-             pos_dev.x - radius, pos_dev.y + magic,
-             pos_dev.x - magic, pos_dev.y + radius,
-             pos_dev.x, pos_dev.y + radius,
-
-             pos_dev.x + magic, pos_dev.y + radius,
-             pos_dev.x + radius, pos_dev.y + magic,
-             pos_dev.x + radius, pos_dev.y,
-
-             pos_dev.x + radius, pos_dev.y - magic,
-             pos_dev.x + magic, pos_dev.y - radius,
-             pos_dev.x, pos_dev.y - radius,
-
-             pos_dev.x - magic, pos_dev.y - radius,
-             pos_dev.x - radius, pos_dev.y - magic,
-             pos_dev.x - radius, pos_dev.y,
-
-             aFill == FILL_T::NO_FILL ? 's' : 'b' );
+    m_workFile->Print( 0,
+                       "%g %g m "
+                       "%g %g %g %g %g %g c "
+                       "%g %g %g %g %g %g c "
+                       "%g %g %g %g %g %g c "
+                       "%g %g %g %g %g %g c %c\n",
+                       pos_dev.x - radius, pos_dev.y,
+
+                       pos_dev.x - radius, pos_dev.y + magic,
+                       pos_dev.x - magic, pos_dev.y + radius,
+                       pos_dev.x, pos_dev.y + radius,
+
+                       pos_dev.x + magic, pos_dev.y + radius,
+                       pos_dev.x + radius, pos_dev.y + magic,
+                       pos_dev.x + radius, pos_dev.y,
+
+                       pos_dev.x + radius, pos_dev.y - magic,
+                       pos_dev.x + magic, pos_dev.y - radius,
+                       pos_dev.x, pos_dev.y - radius,
+
+                       pos_dev.x - magic, pos_dev.y - radius,
+                       pos_dev.x - radius, pos_dev.y - magic,
+                       pos_dev.x - radius, pos_dev.y,
+
+                       aFill == FILL_T::NO_FILL ? 's' : 'b' );
 }
 
 
@@ -358,31 +432,31 @@ void PDF_PLOTTER::Arc( const VECTOR2D& aCenter, const EDA_ANGLE& aStartAngle,
     start.x = KiROUND( aCenter.x + aRadius * ( -startAngle ).Cos() );
     start.y = KiROUND( aCenter.y + aRadius * ( -startAngle ).Sin() );
     VECTOR2D pos_dev = userToDeviceCoordinates( start );
-    fprintf( m_workFile, "%g %g m ", pos_dev.x, pos_dev.y );
+    m_workFile->Print( 0, "%g %g m ", pos_dev.x, pos_dev.y );
 
     for( EDA_ANGLE ii = startAngle + delta; ii < endAngle; ii += delta )
     {
         end.x = KiROUND( aCenter.x + aRadius * ( -ii ).Cos() );
         end.y = KiROUND( aCenter.y + aRadius * ( -ii ).Sin() );
         pos_dev = userToDeviceCoordinates( end );
-        fprintf( m_workFile, "%g %g l ", pos_dev.x, pos_dev.y );
+        m_workFile->Print( 0, "%g %g l ", pos_dev.x, pos_dev.y );
     }
 
     end.x = KiROUND( aCenter.x + aRadius * ( -endAngle ).Cos() );
     end.y = KiROUND( aCenter.y + aRadius * ( -endAngle ).Sin() );
     pos_dev = userToDeviceCoordinates( end );
-    fprintf( m_workFile, "%g %g l ", pos_dev.x, pos_dev.y );
+    m_workFile->Print( 0, "%g %g l ", pos_dev.x, pos_dev.y );
 
     // The arc is drawn... if not filled we stroke it, otherwise we finish
     // closing the pie at the center
     if( aFill == FILL_T::NO_FILL )
     {
-        fputs( "S\n", m_workFile );
+        m_workFile->Print( 0, "S\n" );
     }
     else
     {
         pos_dev = userToDeviceCoordinates( aCenter );
-        fprintf( m_workFile, "%g %g l b\n", pos_dev.x, pos_dev.y );
+        m_workFile->Print( 0, "%g %g l b\n", pos_dev.x, pos_dev.y );
     }
 }
 
@@ -401,21 +475,21 @@ void PDF_PLOTTER::PlotPoly( const std::vector<VECTOR2I>& aCornerList, FILL_T aFi
     SetCurrentLineWidth( aWidth );
 
     VECTOR2D pos = userToDeviceCoordinates( aCornerList[0] );
-    fprintf( m_workFile, "%g %g m\n", pos.x, pos.y );
+    m_workFile->Print( 0, "%g %g m\n", pos.x, pos.y );
 
     for( unsigned ii = 1; ii < aCornerList.size(); ii++ )
     {
         pos = userToDeviceCoordinates( aCornerList[ii] );
-        fprintf( m_workFile, "%g %g l\n", pos.x, pos.y );
+        m_workFile->Print( 0, "%g %g l\n", pos.x, pos.y );
     }
 
     // Close path and stroke and/or fill
     if( aFill == FILL_T::NO_FILL )
-        fputs( "S\n", m_workFile );
+        m_workFile->Print( 0, "S\n" );
     else if( aWidth == 0 )
-        fputs( "f\n", m_workFile );
+        m_workFile->Print( 0, "f\n" );
     else
-        fputs( "b\n", m_workFile );
+        m_workFile->Print( 0, "b\n" );
 }
 
 
@@ -427,7 +501,7 @@ void PDF_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
     {
         if( m_penState != 'Z' )
         {
-            fputs( "S\n", m_workFile );
+            m_workFile->Print( 0, "S\n" );
             m_penState     = 'Z';
             m_penLastpos.x = -1;
             m_penLastpos.y = -1;
@@ -439,9 +513,9 @@ void PDF_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
     if( m_penState != plume || pos != m_penLastpos )
     {
         VECTOR2D pos_dev = userToDeviceCoordinates( pos );
-        fprintf( m_workFile, "%g %g %c\n",
-                 pos_dev.x, pos_dev.y,
-                 ( plume=='D' ) ? 'l' : 'm' );
+        m_workFile->Print( 0, "%g %g %c\n",
+                           pos_dev.x, pos_dev.y,
+                           ( plume=='D' ) ? 'l' : 'm' );
     }
 
     m_penState   = plume;
@@ -449,6 +523,84 @@ void PDF_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
 }
 
 
+void PDF_PLOTTER::FlashPadRoundRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                     int aCornerRadius, const EDA_ANGLE& aOrient,
+                                     OUTLINE_MODE aTraceMode, void* aData )
+{
+    if( aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadRoundRect( aPadPos, aSize, aCornerRadius, aOrient, aTraceMode,
+                                           aData );
+        return;
+    }
+
+    SetCurrentLineWidth( 0 );
+
+    plotAsForm( aPadPos, ( std::abs( aSize.x ) + std::abs( aSize.y ) ) / 2,
+            [&]( const VECTOR2I& aOrigin )
+            {
+                PSLIKE_PLOTTER::FlashPadRoundRect( aOrigin, aSize, aCornerRadius, aOrient,
+                                                   aTraceMode, aData );
+            } );
+}
+
+
+void PDF_PLOTTER::FlashPadCustom( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                  const EDA_ANGLE& aOrient, SHAPE_POLY_SET* aPolygons,
+                                  OUTLINE_MODE aTraceMode, void* aData )
+{
+    if( aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadCustom( aPadPos, aSize, aOrient, aPolygons, aTraceMode, aData );
+        return;
+    }
+
+    SetCurrentLineWidth( 0 );
+
+    BOX2I bbox = aPolygons->BBox();
+    int   radius = std::max( { std::abs( bbox.GetLeft() - aPadPos.x ),
+                               std::abs( bbox.GetRight() - aPadPos.x ),
+                               std::abs( bbox.GetTop() - aPadPos.y ),
+                               std::abs( bbox.GetBottom() - aPadPos.y ) } );
+
+    plotAsForm( aPadPos, radius,
+            [&]( const VECTOR2I& aOrigin )
+            {
+                // The polygons are given at their final position
+                SHAPE_POLY_SET polygons( *aPolygons );
+                polygons.Move( aOrigin - aPadPos );
+
+                PSLIKE_PLOTTER::FlashPadCustom( aOrigin, aSize, aOrient, &polygons, aTraceMode,
+                                                aData );
+            } );
+}
+
+
+void PDF_PLOTTER::FlashPadTrapez( const VECTOR2I& aPadPos, const VECTOR2I* aCorners,
+                                  const EDA_ANGLE& aPadOrient, OUTLINE_MODE aTraceMode,
+                                  void* aData )
+{
+    if( aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadTrapez( aPadPos, aCorners, aPadOrient, aTraceMode, aData );
+        return;
+    }
+
+    SetCurrentLineWidth( 0 );
+
+    double radius = 0.0;
+
+    for( int ii = 0; ii < 4; ii++ )
+        radius = std::max( radius, VECTOR2D( aCorners[ii] ).EuclideanNorm() );
+
+    plotAsForm( aPadPos, KiROUND( radius ) + 1,
+            [&]( const VECTOR2I& aOrigin )
+            {
+                PSLIKE_PLOTTER::FlashPadTrapez( aOrigin, aCorners, aPadOrient, aTraceMode, aData );
+            } );
+}
+
+
 void PDF_PLOTTER::PlotImage( const wxImage& aImage, const VECTOR2I& aPos, double aScaleFactor )
 {
     wxASSERT( m_workFile );
@@ -518,13 +670,13 @@ void PDF_PLOTTER::PlotImage( const wxImage& aImage, const VECTOR2I& aPos, double
        3) restore the CTM
        4) profit
      */
-    fprintf( m_workFile, "q %g 0 0 %g %g %g cm\n", // Step 1
-             userToDeviceSize( drawsize.x ),
-             userToDeviceSize( drawsize.y ),
-             dev_start.x, dev_start.y );
+    m_workFile->Print( 0, "q %g 0 0 %g %g %g cm\n", // Step 1
+                       userToDeviceSize( drawsize.x ),
+                       userToDeviceSize( drawsize.y ),
+                       dev_start.x, dev_start.y );
 
-    fprintf( m_workFile, "/Im%d Do\n", imgHandle );
-    fputs( "Q\n", m_workFile );
+    m_workFile->Print( 0, "/Im%d Do\n", imgHandle );
+    m_workFile->Print( 0, "Q\n" );
 }
 
 
@@ -557,7 +709,7 @@ void PDF_PLOTTER::closePdfObject()
 }
 
 
-int PDF_PLOTTER::startPdfStream( int handle )
+int PDF_PLOTTER::startPdfStream( int handle, const char* aDictEntries )
 {
     wxASSERT( m_outputFile );
     wxASSERT( !m_workFile );
@@ -567,91 +719,119 @@ int PDF_PLOTTER::startPdfStream( int handle )
     // you could allocate more object during stream preparation
     m_streamLengthHandle = allocPdfObject();
 
-    if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
+    bool compress = !ADVANCED_CFG::GetCfg().m_DebugPDFWriter;
+
+    if( !compress )
     {
         fprintf( m_outputFile,
-                 "<< /Length %d 0 R >>\n" // Length is deferred
-                 "stream\n", handle + 1 );
+                 "<< %s/Length %d 0 R >>\n" // Length is deferred
+                 "stream\n", aDictEntries, handle + 1 );
     }
     else
     {
         fprintf( m_outputFile,
-                 "<< /Length %d 0 R /Filter /FlateDecode >>\n" // Length is deferred
-                 "stream\n", handle + 1 );
+                 "<< %s/Length %d 0 R /Filter /FlateDecode >>\n" // Length is deferred
+                 "stream\n", aDictEntries, handle + 1 );
     }
 
-    // Open a temporary file to accumulate the stream
-    m_workFilename = wxFileName::CreateTempFileName( "" );
-    m_workFile = wxFopen( m_workFilename, wxT( "w+b" ) );
-    wxASSERT( m_workFile );
+    // The stream is accumulated (and compressed) in memory
+    m_pageStream = std::make_unique<PDF_STREAM_FORMATTER>( compress );
+    m_workFile = m_pageStream.get();
     return handle;
 }
 
 
 void PDF_PLOTTER::closePdfStream()
+{
+    wxASSERT( m_pageStream && m_workFile == m_pageStream.get() );
+
+    size_t out_count = m_pageStream->WriteTo( m_outputFile );
+
+    m_pageStream.reset();
+    m_workFile = nullptr;
+
+    fputs( "\nendstream\n", m_outputFile );
+    closePdfObject();
+
+    // Writing the deferred length as an indirect object
+    startPdfObject( m_streamLengthHandle );
+    fprintf( m_outputFile, "%u\n", (unsigned) out_count );
+    closePdfObject();
+}
+
+
+void PDF_PLOTTER::plotAsForm( const VECTOR2I& aPos, int aRadius,
+                              const std::function<void( const VECTOR2I& aOrigin )>& aPlotFunc )
 {
     wxASSERT( m_workFile );
 
-    long stream_len = ftell( m_workFile );
+    // The item is plotted at the plot offset.  User to device coordinates is an affine
+    // transform, so the captured content only depends on the item itself and moving it to
+    // aPos is a plain translation.
+    const VECTOR2I   origin = m_plotOffset;
+    STRING_FORMATTER formatter;
+    OUTPUTFORMATTER* pageStream = m_workFile;
+    int              penWidth = m_currentPenWidth;
 
-    if( stream_len < 0 )
-    {
-        wxASSERT( false );
-        return;
-    }
+    m_workFile = &formatter;
+    m_capturingForm = true;
+    aPlotFunc( origin );
+    m_capturingForm = false;
+    m_workFile = pageStream;
 
-    // Rewind the file, read in the page stream and DEFLATE it
-    fseek( m_workFile, 0, SEEK_SET );
-    unsigned char *inbuf = new unsigned char[stream_len];
+    // The graphics state is restored after the form is drawn, so a pen width set in the form
+    // does not apply to what comes next
+    m_currentPenWidth = penWidth;
 
-    int rc = fread( inbuf, 1, stream_len, m_workFile );
-    wxASSERT( rc == stream_len );
-    ignore_unused( rc );
+    const std::string& content = formatter.GetString();
 
-    // We are done with the temporary file, junk it
-    fclose( m_workFile );
-    m_workFile = nullptr;
-    ::wxRemoveFile( m_workFilename );
+    if( content.empty() )
+        return;
 
-    unsigned out_count;
+    VECTOR2D offset = userToDeviceCoordinates( aPos ) - userToDeviceCoordinates( origin );
+    auto     it = m_formHandles.find( content );
 
-    if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
+    // Unique items (most texts are) would only get bigger as a form, so only remember them the
+    // first time and plot them inline.
+    if( it == m_formHandles.end() )
     {
-        out_count = stream_len;
-        fwrite( inbuf, out_count, 1, m_outputFile );
+        m_formHandles.emplace( content, 0 );
+        m_workFile->Print( 0, "q 1 0 0 1 %g %g cm\n%sQ\n", offset.x, offset.y,
+                           content.c_str() );
+        return;
     }
-    else
-    {
-        // NULL means memos owns the memory, but provide a hint on optimum size needed.
-        wxMemoryOutputStream    memos( nullptr, std::max( 2000l, stream_len ) ) ;
-
-        {
-            /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
-             * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
-             * stream! (a DEFLATE stream would be generated with -15 instead of 15)
-             * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
-             *                    8, Z_DEFAULT_STRATEGY );
-             */
 
-            wxZlibOutputStream      zos( memos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
+    int& handle = it->second;
 
-            zos.Write( inbuf, stream_len );
-        }   // flush the zip stream using zos destructor
+    if( handle == 0 )
+    {
+        VECTOR2D corner1 = userToDeviceCoordinates( origin - VECTOR2I( aRadius, aRadius ) );
+        VECTOR2D corner2 = userToDeviceCoordinates( origin + VECTOR2I( aRadius, aRadius ) );
+        BOX2D    bbox;
 
-        wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
+        bbox.SetOrigin( std::min( corner1.x, corner2.x ), std::min( corner1.y, corner2.y ) );
+        bbox.SetEnd( std::max( corner1.x, corner2.x ), std::max( corner1.y, corner2.y ) );
 
-        out_count = sb->Tell();
-        fwrite( sb->GetBufferStart(), 1, out_count, m_outputFile );
+        handle = allocPdfObject();
+        m_forms[handle] = { content, bbox };
     }
 
-    delete[] inbuf;
-    fputs( "\nendstream\n", m_outputFile );
-    closePdfObject();
+    m_workFile->Print( 0, "q 1 0 0 1 %g %g cm /Fm%d Do Q\n", offset.x, offset.y, handle );
+}
 
-    // Writing the deferred length as an indirect object
-    startPdfObject( m_streamLengthHandle );
-    fprintf( m_outputFile, "%u\n", out_count );
-    closePdfObject();
+
+void PDF_PLOTTER::emitForms()
+{
+    for( const auto& [handle, form] : m_forms )
+    {
+        std::string dict = StrPrintf( "/Type /XObject /Subtype /Form /BBox [%g %g %g %g] ",
+                                      form.m_bbox.GetLeft(), form.m_bbox.GetTop(),
+                                      form.m_bbox.GetRight(), form.m_bbox.GetBottom() );
+
+        startPdfStream( handle, dict.c_str() );
+        m_workFile->Print( 0, "%s", form.m_content.c_str() );
+        closePdfStream();
+    }
 }
 
 
@@ -675,10 +855,10 @@ void PDF_PLOTTER::StartPage( const wxString& aPageNumber, const wxString& aPageN
        compressed later in closePdfStream */
 
     // Default graphic settings (coordinate system, default color and line style)
-    fprintf( m_workFile,
-             "%g 0 0 %g 0 0 cm 1 J 1 j 0 0 0 rg 0 0 0 RG %g w\n",
-             0.0072 * plotScaleAdjX, 0.0072 * plotScaleAdjY,
-             userToDeviceSize( m_renderSettings->GetDefaultPenWidth() ) );
+    m_workFile->Print( 0,
+                       "%g 0 0 %g 0 0 cm 1 J 1 j 0 0 0 rg 0 0 0 RG %g w\n",
+                       0.0072 * plotScaleAdjX, 0.0072 * plotScaleAdjY,
+                       userToDeviceSize( m_renderSettings->GetDefaultPenWidth() ) );
 }
 
 
@@ -941,6 +1121,8 @@ bool PDF_PLOTTER::StartPlot( const wxString& aPageNumber, const wxString& aPageN
     m_hyperlinkHandles.clear();
     m_hyperlinkMenuHandles.clear();
     m_bookmarksInPage.clear();
+    m_formHandles.clear();
+    m_forms.clear();
     m_totalOutlineNodes = 0;
 
     m_outlineRoot = std::make_unique<OUTLINE_NODE>();
@@ -1114,6 +1296,9 @@ bool PDF_PLOTTER::EndPlot()
     // Close the current page (often the only one)
     ClosePage();
 
+    // The forms shared by the pages
+    emitForms();
+
     /* We need to declare the resources we're using (fonts in particular)
        The useful standard one is the Helvetica family. Adding external fonts
        is *very* involved! */
@@ -1168,6 +1353,9 @@ bool PDF_PLOTTER::EndPlot()
         fprintf( m_outputFile, "    /Im%d %d 0 R\n", imgHandle, imgHandle );
     }
 
+    for( const auto& [formHandle, form] : m_forms )
+        fprintf( m_outputFile, "    /Fm%d %d 0 R\n", formHandle, formHandle );
+
     fputs( ">>\n", m_outputFile );
     closePdfObject();
 
@@ -1639,19 +1827,48 @@ void PDF_PLOTTER::Text( const VECTOR2I&        aPos,
            coordinate system will be used for the overlining. Also the %f
            for the trig part of the matrix to avoid %g going in exponential
            format (which is not supported) */
-        fprintf( m_workFile, "q %f %f %f %f %g %g cm BT %s %g Tf %d Tr %g Tz ",
-                 ctm_a, ctm_b, ctm_c, ctm_d, ctm_e, ctm_f,
-                 fontname, heightFactor, render_mode, wideningFactor * 100 );
+        m_workFile->Print( 0, "q %f %f %f %f %g %g cm BT %s %g Tf %d Tr %g Tz ",
+                           ctm_a, ctm_b, ctm_c, ctm_d, ctm_e, ctm_f,
+                           fontname, heightFactor, render_mode, wideningFactor * 100 );
 
         std::string txt_pdf = encodeStringForPlotter( word );
-        fprintf( m_workFile, "%s Tj ET\n", txt_pdf.c_str() );
+        m_workFile->Print( 0, "%s Tj ET\n", txt_pdf.c_str() );
         // Restore the CTM
-        fputs( "Q\n", m_workFile );
+        m_workFile->Print( 0, "Q\n" );
     }
 
-    // Plot the stroked text (if requested)
-    PLOTTER::Text( aPos, aColor, aText, aOrient, aSize, aH_justify, aV_justify, aWidth, aItalic,
-                   aBold, aMultilineAllowed, aFont, aFontMetrics );
+    // Plot the stroked text (if requested).  The same texts (pin numbers, net names, values)
+    // are used a lot, so the repeated ones are emitted once and reused, in the color set above.
+    // full_box measures the text as a single line, so the form extent of multiline text is
+    // measured line by line.
+    VECTOR2D extent( full_box );
+
+    if( aMultilineAllowed && aText.Contains( wxT( "\n" ) ) )
+    {
+        wxArrayString lines;
+        wxStringSplit( aText, lines, '\n' );
+
+        extent = VECTOR2D( 0, 0 );
+
+        for( const wxString& line : lines )
+        {
+            extent.x = std::max( extent.x, std::abs( (double) aFont->StringBoundaryLimits(
+                                                       line, t_size, aWidth, aBold, aItalic,
+                                                       aFontMetrics ).x ) );
+        }
+
+        extent.y = std::abs( full_box.y )
+                   + ( lines.size() - 1 ) * aFont->GetInterline( t_size.y, aFontMetrics );
+    }
+
+    int radius = KiROUND( extent.EuclideanNorm() + VECTOR2D( t_size ).EuclideanNorm() ) + aWidth;
+
+    plotAsForm( aPos, radius,
+            [&]( const VECTOR2I& aOrigin )
+            {
+                PLOTTER::Text( aOrigin, aColor, aText, aOrient, aSize, aH_justify, aV_justify,
+                               aWidth, aItalic, aBold, aMultilineAllowed, aFont, aFontMetrics );
+            } );
 }
 
 
@@ -86,13 +86,16 @@
  * The center of ellipse is automatically calculated.
  */
 
+#include <convert_basic_shapes_to_polygon.h>
 #include <core/base64.h>
 #include <eda_shape.h>
+#include <geometry/shape_poly_set.h>
 #include <string_utils.h>
 #include <font/font.h>
 #include <macros.h>
 #include <trigo.h>
 
+#include <cmath>
 #include <cstdint>
 #include <wx/mstream.h>
 
@@ -172,6 +175,7 @@ SVG_PLOTTER::SVG_PLOTTER()
     m_brush_alpha     = 1.0;
     m_dashed          = LINE_STYLE::SOLID;
     m_precision       = 4;               // default: 4 digits in mantissa.
+    m_useSymbols      = false;
 }
 
 
@@ -646,6 +650,127 @@ void SVG_PLOTTER::PlotPoly( const std::vector<VECTOR2I>& aCornerList, FILL_T aFi
 }
 
 
+void SVG_PLOTTER::flashPolygonsAsSymbol( const VECTOR2I& aPos, const SHAPE_POLY_SET& aPolygons )
+{
+    // Device coordinates are an affine transform of the user coordinates, so the shape relative
+    // to the pad does not depend on the pad position.
+    const VECTOR2D origin = userToDeviceCoordinates( m_plotOffset );
+    const double   scale = std::pow( 10.0, m_precision );
+    std::string    paths;
+
+    // One path for each outline, like PlotPoly() does: in a single path, overlapping outlines
+    // of custom pads would cancel each other out with the evenodd fill rule.
+    for( int ii = 0; ii < aPolygons.OutlineCount(); ++ii )
+    {
+        const SHAPE_LINE_CHAIN& outline = aPolygons.COutline( ii );
+
+        if( outline.PointCount() == 0 )
+            continue;
+
+        paths += "<path d=\"";
+
+        for( int jj = 0; jj < outline.PointCount(); ++jj )
+        {
+            VECTOR2D pt = userToDeviceCoordinates( m_plotOffset + outline.CPoint( jj ) ) - origin;
+
+            paths += StrPrintf( "%c%d %d ", jj == 0 ? 'M' : 'L', KiROUND( pt.x * scale ),
+                                KiROUND( pt.y * scale ) );
+        }
+
+        paths += "Z\" />";
+    }
+
+    if( paths.empty() )
+        return;
+
+    auto it = m_symbolIds.find( paths );
+    int  id;
+
+    if( it != m_symbolIds.end() )
+    {
+        id = it->second;
+    }
+    else
+    {
+        id = (int) m_symbols.size();
+        m_symbolIds.emplace( paths, id );
+        m_symbols.push_back( std::move( paths ) );
+    }
+
+    setFillMode( FILL_T::FILLED_SHAPE );
+    SetCurrentLineWidth( 0 );
+
+    VECTOR2D pos = userToDeviceCoordinates( aPos );
+
+    fprintf( m_outputFile, "<use xlink:href=\"#kicad_pad%d\" x=\"%.*f\" y=\"%.*f\" ",
+             id, m_precision, pos.x, m_precision, pos.y );
+    setSVGPlotStyle( 0, false, "fill-rule:evenodd;" );
+    fputs( "/>\n", m_outputFile );
+}
+
+
+void SVG_PLOTTER::FlashPadRoundRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                     int aCornerRadius, const EDA_ANGLE& aOrient,
+                                     OUTLINE_MODE aTraceMode, void* aData )
+{
+    if( !m_useSymbols || aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadRoundRect( aPadPos, aSize, aCornerRadius, aOrient, aTraceMode,
+                                           aData );
+        return;
+    }
+
+    SHAPE_POLY_SET outline;
+    TransformRoundChamferedRectToPolygon( outline, VECTOR2I( 0, 0 ), aSize, aOrient,
+                                          aCornerRadius, 0.0, 0, 0, GetPlotterArcHighDef(),
+                                          ERROR_INSIDE );
+
+    flashPolygonsAsSymbol( aPadPos, outline );
+}
+
+
+void SVG_PLOTTER::FlashPadCustom( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                  const EDA_ANGLE& aOrient, SHAPE_POLY_SET* aPolygons,
+                                  OUTLINE_MODE aTraceMode, void* aData )
+{
+    if( !m_useSymbols || aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadCustom( aPadPos, aSize, aOrient, aPolygons, aTraceMode, aData );
+        return;
+    }
+
+    // The polygons are given at their final position
+    SHAPE_POLY_SET polygons( *aPolygons );
+    polygons.Move( -aPadPos );
+
+    flashPolygonsAsSymbol( aPadPos, polygons );
+}
+
+
+void SVG_PLOTTER::FlashPadTrapez( const VECTOR2I& aPadPos, const VECTOR2I* aCorners,
+                                  const EDA_ANGLE& aPadOrient, OUTLINE_MODE aTraceMode,
+                                  void* aData )
+{
+    if( !m_useSymbols || aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadTrapez( aPadPos, aCorners, aPadOrient, aTraceMode, aData );
+        return;
+    }
+
+    SHAPE_POLY_SET outline;
+    outline.NewOutline();
+
+    for( int ii = 0; ii < 4; ii++ )
+    {
+        VECTOR2I corner = aCorners[ii];
+        RotatePoint( corner, aPadOrient );
+        outline.Append( corner );
+    }
+
+    flashPolygonsAsSymbol( aPadPos, outline );
+}
+
+
 void SVG_PLOTTER::PlotImage( const wxImage& aImage, const VECTOR2I& aPos, double aScaleFactor )
 {
     VECTOR2I pix_size( aImage.GetWidth(), aImage.GetHeight() );
@@ -815,13 +940,37 @@ bool SVG_PLOTTER::StartPlot( const wxString& aPageNumber )
     // output the pen cap and line joint
     fputs( "stroke-linecap:round; stroke-linejoin:round;\"\n", m_outputFile );
     fputs( " transform=\"translate(0 0) scale(1 1)\">\n", m_outputFile );
+
+    m_symbolIds.clear();
+    m_symbols.clear();
+
     return true;
 }
 
 
 bool SVG_PLOTTER::EndPlot()
 {
-    fputs( "</g> \n</svg>\n", m_outputFile );
+    fputs( "</g> \n", m_outputFile );
+
+    if( !m_symbols.empty() )
+    {
+        // Symbol coordinates are integers, in units of the coordinate precision
+        double scale = std::pow( 10.0, -(int) m_precision );
+
+        fputs( "<defs>\n", m_outputFile );
+
+        for( size_t ii = 0; ii < m_symbols.size(); ++ii )
+        {
+            fprintf( m_outputFile,
+                     "<symbol id=\"kicad_pad%zu\" overflow=\"visible\">"
+                     "<g transform=\"scale(%g)\">%s</g></symbol>\n",
+                     ii, scale, m_symbols[ii].c_str() );
+        }
+
+        fputs( "</defs>\n", m_outputFile );
+    }
+
+    fputs( "</svg>\n", m_outputFile );
     fclose( m_outputFile );
     m_outputFile = nullptr;
 
@@ -44,6 +44,7 @@ RENDER_SETTINGS::RENDER_SETTINGS() :
     m_drawingSheetLineWidth = 100000;
     m_defaultPenWidth       = 0;
     m_minPenWidth           = 0;
+    m_lodTolerance          = 0;
     m_isPrinting            = false;
     m_printBlackAndWite     = false;
 }
@@ -40,6 +40,7 @@
 #include <gal/painter.h>
 
 #include <core/profile.h>
+#include <core/thread_pool.h>
 
 #ifdef KICAD_GAL_PROFILE
 #include <wx/log.h>
@@ -58,6 +59,7 @@ public:
         m_requiredUpdate( KIGFX::NONE ),
         m_drawPriority( 0 ),
         m_cachedIndex( -1 ),
+        m_dirtyIndex( -1 ),
         m_groups( nullptr ),
         m_groupsSize( 0 ) {}
 
@@ -230,6 +232,7 @@ private:
     int                  m_requiredUpdate;   ///< Flag required for updating
     int                  m_drawPriority;     ///< Order to draw this item in a layer, lowest first
     int                  m_cachedIndex;      ///< Cached index in m_allItems.
+    int                  m_dirtyIndex;       ///< Index in VIEW::m_dirtyItems, if queued.
 
     std::pair<int, int>* m_groups;           ///< layer_number:group_id pairs for each layer the
                                              ///< item occupies.
@@ -264,7 +267,9 @@ VIEW::VIEW( bool aIsDynamic ) :
     m_dynamic( aIsDynamic ),
     m_useDrawPriority( false ),
     m_nextDrawPriority( 0 ),
-    m_reverseDrawOrder( false )
+    m_reverseDrawOrder( false ),
+    m_lodThreshold( 0.0 ),
+    m_lodBand( 0 )
 {
     // Set m_boundary to define the max area size. The default area size
     // is defined here as the max value of a int.
@@ -298,6 +303,7 @@ VIEW::VIEW( bool aIsDynamic ) :
         m_layers[ii].displayOnly    = false;
         m_layers[ii].diffLayer      = false;
         m_layers[ii].hasNegatives   = false;
+        m_layers[ii].lod            = false;
         m_layers[ii].target         = TARGET_CACHED;
     }
 
@@ -375,6 +381,16 @@ void VIEW::Remove( VIEW_ITEM* aItem )
             item = std::find( m_allItems->begin(), m_allItems->end(), aItem );
         }
 
+        int dirtyIndex = aItem->m_viewPrivData->m_dirtyIndex;
+
+        if( dirtyIndex >= 0 && dirtyIndex < static_cast<int>( m_dirtyItems.size() )
+            && m_dirtyItems[dirtyIndex] == aItem )
+        {
+            m_dirtyItems[dirtyIndex] = nullptr;
+        }
+
+        aItem->m_viewPrivData->m_dirtyIndex = -1;
+
         if( item != m_allItems->end() )
         {
             *item = nullptr;
@@ -605,11 +621,66 @@ void VIEW::SetScale( double aScale, VECTOR2D aAnchor )
 
     SetCenter( m_center - delta );
 
+    updateLOD();
+
     // Redraw everything after the viewport has changed
     MarkDirty();
 }
 
 
+void VIEW::SetLODThreshold( double aPixelSize )
+{
+    m_lodThreshold = aPixelSize;
+    updateLOD();
+}
+
+
+void VIEW::updateLOD()
+{
+    int    band = 0;
+    double bandStart = m_lodThreshold;
+
+    if( m_lodThreshold > 0.0 && m_gal )
+    {
+        const double pixelSize = ToWorld( 1.0 );
+
+        while( pixelSize >= bandStart * 4.0 )
+        {
+            bandStart *= 4.0;
+            band++;
+        }
+
+        if( pixelSize >= m_lodThreshold )
+            band++;
+    }
+
+    if( band == m_lodBand )
+        return;
+
+    m_lodBand = band;
+
+    // Allow at most the size of one pixel at the start of the band
+    if( m_painter )
+        m_painter->GetSettings()->SetLODTolerance( band > 0 ? KiROUND( bandStart ) : 0 );
+
+    BOX2I r;
+    r.SetMaximum();
+
+    auto repaint =
+            [&]( VIEW_ITEM* aItem )
+            {
+                Update( aItem, REPAINT );
+                return true;
+            };
+
+    for( VIEW_LAYER& layer : m_layers )
+    {
+        if( layer.lod )
+            layer.items->Query( r, repaint );
+    }
+}
+
+
 void VIEW::SetCenter( const VECTOR2D& aCenter )
 {
     m_center = aCenter;
@@ -746,7 +817,7 @@ void VIEW::ReorderLayerData( std::unordered_map<int, int> aReorderMap )
 
         viewData->reorderGroups( aReorderMap );
 
-        viewData->m_requiredUpdate |= COLOR;
+        Update( item, COLOR );
     }
 
     UpdateItems();
@@ -1170,6 +1241,7 @@ void VIEW::Clear()
     BOX2I r;
     r.SetMaximum();
     m_allItems->clear();
+    m_dirtyItems.clear();
 
     for( VIEW_LAYER& layer : m_layers )
         layer.items->RemoveAll();
@@ -1473,27 +1545,26 @@ void VIEW::UpdateItems()
     if( !m_gal->IsVisible() || !m_gal->IsInitialized() )
         return;
 
+    std::vector<VIEW_ITEM*> dirtyItems;
+    dirtyItems.swap( m_dirtyItems );
+
     unsigned int cntGeomUpdate = 0;
     bool         anyUpdated = false;
 
-    for( VIEW_ITEM* item : *m_allItems )
+    for( VIEW_ITEM* item : dirtyItems )
     {
         if( !item )
             continue;
 
-        auto vpd = item->viewPrivData();
-
-        if( !vpd )
-            continue;
+        VIEW_ITEM_DATA* vpd = item->viewPrivData();
+        vpd->m_dirtyIndex = -1;
 
         if( vpd->m_requiredUpdate != NONE )
         {
             anyUpdated = true;
 
             if( vpd->m_requiredUpdate & ( GEOMETRY | LAYERS ) )
-            {
                 cntGeomUpdate++;
-            }
         }
     }
 
@@ -1508,46 +1579,33 @@ void VIEW::UpdateItems()
     // for larger designs...
 
     if( ratio > 0.3 )
-    {
-        auto allItems = *m_allItems;
-        int  layers[VIEW_MAX_LAYERS], layers_count;
-
-        // kill all Rtrees
-        for( VIEW_LAYER& layer : m_layers )
-            layer.items->RemoveAll();
+        rebuildAllLayers();
 
-        // and re-insert items from scratch
-        for( VIEW_ITEM* item : allItems )
+    if( anyUpdated )
+    {
+        // Let the painter build the geometry of the items about to be recached up front
+        if( m_painter )
         {
-            if( !item )
-                continue;
+            std::vector<const VIEW_ITEM*> redrawItems;
 
-            const BOX2I bbox = item->ViewBBox();
-            item->m_viewPrivData->m_bbox = bbox;
-
-            item->ViewGetLayers( layers, layers_count );
-            item->viewPrivData()->saveLayers( layers, layers_count );
-
-            for( int i = 0; i < layers_count; ++i )
+            for( VIEW_ITEM* item : dirtyItems )
             {
-                wxCHECK2_MSG( layers[i] >= 0 && static_cast<unsigned>( layers[i] ) < m_layers.size(),
-                        continue, wxS( "Invalid layer" ) );
-                VIEW_LAYER& l = m_layers[layers[i]];
-                l.items->Insert( item, bbox );
-                MarkTargetDirty( l.target );
+                if( item && ( item->viewPrivData()->m_requiredUpdate
+                              & ( GEOMETRY | LAYERS | REPAINT | INITIAL_ADD ) ) )
+                {
+                    redrawItems.push_back( item );
+                }
             }
 
-            item->viewPrivData()->m_requiredUpdate &= ~( LAYERS | GEOMETRY );
+            if( !redrawItems.empty() )
+                m_painter->PrepareItems( redrawItems );
         }
-    }
 
-    if( anyUpdated )
-    {
         GAL_UPDATE_CONTEXT ctx( m_gal );
 
-        for( VIEW_ITEM* item : *m_allItems.get() )
+        for( VIEW_ITEM* item : dirtyItems )
         {
-            if( item && item->viewPrivData() && item->viewPrivData()->m_requiredUpdate != NONE )
+            if( item && item->viewPrivData()->m_requiredUpdate != NONE )
             {
                 invalidateItem( item, item->viewPrivData()->m_requiredUpdate );
                 item->viewPrivData()->m_requiredUpdate = NONE;
@@ -1555,8 +1613,65 @@ void VIEW::UpdateItems()
         }
     }
 
-    KI_TRACE( traceGalProfile, wxS( "View update: total items %u, geom %u anyUpdated %u\n" ), cntTotal,
-              cntGeomUpdate, (unsigned) anyUpdated );
+    KI_TRACE( traceGalProfile, wxS( "View update: total items %u, dirty %u, geom %u anyUpdated %u\n" ),
+              cntTotal, (unsigned) dirtyItems.size(), cntGeomUpdate, (unsigned) anyUpdated );
+}
+
+
+void VIEW::rebuildAllLayers()
+{
+    std::vector<std::vector<std::pair<VIEW_ITEM*, BOX2I>>> layerItems( m_layers.size() );
+    int layers[VIEW_MAX_LAYERS], layers_count;
+
+    // Bounding boxes and layers are gathered serially; the items' own caches are not
+    // thread-safe.
+    for( VIEW_ITEM* item : *m_allItems )
+    {
+        if( !item )
+            continue;
+
+        const BOX2I bbox = item->ViewBBox();
+        item->m_viewPrivData->m_bbox = bbox;
+
+        item->ViewGetLayers( layers, layers_count );
+        item->viewPrivData()->saveLayers( layers, layers_count );
+
+        for( int i = 0; i < layers_count; ++i )
+        {
+            wxCHECK2_MSG( layers[i] >= 0 && static_cast<unsigned>( layers[i] ) < m_layers.size(),
+                          continue, wxS( "Invalid layer" ) );
+
+            layerItems[layers[i]].emplace_back( item, bbox );
+        }
+
+        item->viewPrivData()->m_requiredUpdate &= ~( LAYERS | GEOMETRY );
+    }
+
+    // Each layer has its own R-tree, so the trees can be rebuilt independently
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::vector<std::future<void>> returns;
+
+    for( size_t ii = 0; ii < m_layers.size(); ++ii )
+    {
+        VIEW_LAYER& l = m_layers[ii];
+
+        l.items->RemoveAll();
+
+        if( layerItems[ii].empty() )
+            continue;
+
+        MarkTargetDirty( l.target );
+
+        returns.emplace_back( tp.submit(
+                [&l, &items = layerItems[ii]]()
+                {
+                    for( const auto& [item, bbox] : items )
+                        l.items->Insert( item, bbox );
+                } ) );
+    }
+
+    for( std::future<void>& ret : returns )
+        ret.wait();
 }
 
 
@@ -1565,7 +1680,7 @@ void VIEW::UpdateAllItems( int aUpdateFlags )
     for( VIEW_ITEM* item : *m_allItems )
     {
         if( item && item->viewPrivData() )
-            item->viewPrivData()->m_requiredUpdate |= aUpdateFlags;
+            Update( item, aUpdateFlags );
     }
 }
 
@@ -1581,7 +1696,7 @@ void VIEW::UpdateAllItemsConditionally( int aUpdateFlags,
         if( aCondition( item ) )
         {
             if( item->viewPrivData() )
-                item->viewPrivData()->m_requiredUpdate |= aUpdateFlags;
+                Update( item, aUpdateFlags );
         }
     }
 }
@@ -1595,7 +1710,12 @@ void VIEW::UpdateAllItemsConditionally( std::function<int( VIEW_ITEM* )> aItemFl
             continue;
 
         if( item->viewPrivData() )
-            item->viewPrivData()->m_requiredUpdate |= aItemFlagsProvider( item );
+        {
+            int flags = aItemFlagsProvider( item );
+
+            if( flags != NONE )
+                Update( item, flags );
+        }
     }
 }
 
@@ -1694,6 +1814,22 @@ void VIEW::Update( const VIEW_ITEM* aItem, int aUpdateFlags ) const
     assert( aUpdateFlags != NONE );
 
     viewData->m_requiredUpdate |= aUpdateFlags;
+
+    // Queue the item on the view owning it, so that UpdateItems() only has to visit the
+    // items that actually changed.  Removed items are not queued; Add() queues them again.
+    VIEW* view = viewData->m_view;
+
+    if( !view )
+        return;
+
+    std::vector<VIEW_ITEM*>& dirtyItems = view->m_dirtyItems;
+    int                      idx = viewData->m_dirtyIndex;
+
+    if( idx >= 0 && idx < static_cast<int>( dirtyItems.size() ) && dirtyItems[idx] == aItem )
+        return;
+
+    viewData->m_dirtyIndex = dirtyItems.size();
+    dirtyItems.push_back( const_cast<VIEW_ITEM*>( aItem ) );
 }
 
 
@@ -37,6 +37,8 @@
 #include <tools/ee_selection_tool.h>
 #include <trigo.h>
 
+#include <deque>
+
 
 void SCH_EDIT_FRAME::TestDanglingEnds()
 {
@@ -63,11 +65,11 @@ bool SCH_EDIT_FRAME::TrimWire( SCH_COMMIT* aCommit, const VECTOR2I& aStart, cons
 
     // We cannot modify the RTree while iterating, so push the possible
     // wires into a separate structure.
-    for( EDA_ITEM* item : screen->Items().Overlapping( bb ) )
+    for( SCH_ITEM* item : screen->Items().Overlapping( SCH_LINE_T, bb ) )
     {
         SCH_LINE* line = static_cast<SCH_LINE*>( item );
 
-        if( item->Type() == SCH_LINE_T && line->GetLayer() == LAYER_WIRE )
+        if( line->GetLayer() == LAYER_WIRE )
             wires.push_back( line );
     }
 
@@ -122,15 +124,12 @@ void SCH_EDIT_FRAME::SchematicCleanUp( SCH_COMMIT* aCommit, SCH_SCREEN* aScreen
     std::vector<SCH_JUNCTION*>   junctions;
     std::vector<SCH_NO_CONNECT*> ncs;
     std::vector<SCH_ITEM*>       items_to_remove;
-    bool                         changed = true;
 
     if( aScreen == nullptr )
         aScreen = GetScreen();
 
     auto remove_item = [&]( SCH_ITEM* aItem ) -> void
                        {
-                           changed = true;
-
                            if( !( aItem->GetFlags() & STRUCT_DELETED ) )
                            {
                                aItem->SetFlags( STRUCT_DELETED );
@@ -159,31 +158,35 @@ void SCH_EDIT_FRAME::SchematicCleanUp( SCH_COMMIT* aCommit, SCH_SCREEN* aScreen
     for( SCH_ITEM* item : aScreen->Items().OfType( SCH_NO_CONNECT_T ) )
         ncs.push_back( static_cast<SCH_NO_CONNECT*>( item ) );
 
-    alg::for_all_pairs( junctions.begin(), junctions.end(),
-            [&]( SCH_JUNCTION* aFirst, SCH_JUNCTION* aSecond )
-            {
-                if( ( aFirst->GetEditFlags() & STRUCT_DELETED )
-                        || ( aSecond->GetEditFlags() & STRUCT_DELETED ) )
-                {
-                    return;
-                }
-
-                if( aFirst->GetPosition() == aSecond->GetPosition() )
-                    remove_item( aSecond );
-            } );
-
-    alg::for_all_pairs( ncs.begin(), ncs.end(),
-            [&]( SCH_NO_CONNECT* aFirst, SCH_NO_CONNECT* aSecond )
+    // Remove the junctions and no-connects stacked on an earlier one.  Look them up in the
+    // RTree rather than comparing every pair.
+    auto removeStacked =
+            [&]( const auto& aItems )
             {
-                if( ( aFirst->GetEditFlags() & STRUCT_DELETED )
-                        || ( aSecond->GetEditFlags() & STRUCT_DELETED ) )
+                for( SCH_ITEM* item : aItems )
                 {
-                    return;
+                    if( item->GetEditFlags() & STRUCT_DELETED )
+                        continue;
+
+                    std::vector<SCH_ITEM*> stacked;
+
+                    for( SCH_ITEM* other : aScreen->Items().Overlapping( item->Type(),
+                                                                         item->GetPosition() ) )
+                    {
+                        if( other != item && !( other->GetEditFlags() & STRUCT_DELETED )
+                                && other->GetPosition() == item->GetPosition() )
+                        {
+                            stacked.push_back( other );
+                        }
+                    }
+
+                    for( SCH_ITEM* other : stacked )
+                        remove_item( other );
                 }
+            };
 
-                if( aFirst->GetPosition() == aSecond->GetPosition() )
-                    remove_item( aSecond );
-            } );
+    removeStacked( junctions );
+    removeStacked( ncs );
 
 
     auto minX = []( const SCH_LINE* l )
@@ -208,93 +211,108 @@ void SCH_EDIT_FRAME::SchematicCleanUp( SCH_COMMIT* aCommit, SCH_SCREEN* aScreen
 
     // Would be nice to put lines in a canonical form here by swapping
     //  start <-> end as needed but I don't know what swapping breaks.
-    while( changed )
+    for( SCH_ITEM* item : aScreen->Items().OfType( SCH_LINE_T ) )
     {
-        changed = false;
-        lines.clear();
+        if( item->GetLayer() == LAYER_WIRE || item->GetLayer() == LAYER_BUS )
+            lines.push_back( static_cast<SCH_LINE*>( item ) );
+    }
+
+    // Sort by minimum X position
+    std::sort( lines.begin(), lines.end(),
+               [&]( const SCH_LINE* a, const SCH_LINE* b )
+               {
+                   return minX( a ) < minX( b );
+               } );
+
+    // Lines are checked against their neighbours from the RTree.  A line is checked again
+    // when a neighbour was removed or merged, as that can allow more merges around it.
+    std::deque<SCH_LINE*> pending( lines.begin(), lines.end() );
 
-        for( SCH_ITEM* item : aScreen->Items().OfType( SCH_LINE_T ) )
+    while( !pending.empty() )
+    {
+        SCH_LINE* firstLine = pending.front();
+        pending.pop_front();
+
+        if( firstLine->GetEditFlags() & STRUCT_DELETED )
+            continue;
+
+        if( firstLine->IsNull() )
         {
-            if( item->GetLayer() == LAYER_WIRE || item->GetLayer() == LAYER_BUS )
-                lines.push_back( static_cast<SCH_LINE*>( item ) );
+            remove_item( firstLine );
+            continue;
         }
 
-        // Sort by minimum X position
-        std::sort( lines.begin(), lines.end(),
-                   [&]( const SCH_LINE* a, const SCH_LINE* b )
-                   {
-                       return minX( a ) < minX( b );
-                   } );
+        // We cannot modify the RTree while iterating, so push the possible
+        // lines into a separate structure.
+        std::vector<SCH_LINE*> neighbours;
 
-        for( auto it1 = lines.begin(); it1 != lines.end(); ++it1 )
+        for( SCH_ITEM* item : aScreen->Items().Overlapping( SCH_LINE_T,
+                                                             firstLine->GetBoundingBox() ) )
         {
-            SCH_LINE* firstLine = *it1;
+            if( item != firstLine && item->GetLayer() == firstLine->GetLayer() )
+                neighbours.push_back( static_cast<SCH_LINE*>( item ) );
+        }
 
-            if( firstLine->GetEditFlags() & STRUCT_DELETED )
+        bool removedNeighbour = false;
+
+        for( SCH_LINE* secondLine : neighbours )
+        {
+            if( secondLine->GetFlags() & STRUCT_DELETED )
                 continue;
 
-            if( firstLine->IsNull() )
+            // No X or Y axis overlap
+            if( std::max( minX( firstLine ), minX( secondLine ) )
+                        > std::min( maxX( firstLine ), maxX( secondLine ) )
+                    || std::max( minY( firstLine ), minY( secondLine ) )
+                        > std::min( maxY( firstLine ), maxY( secondLine ) ) )
             {
-                remove_item( firstLine );
                 continue;
             }
 
-            int  firstRightXEdge = maxX( firstLine );
-            auto it2 = it1;
+            if( !secondLine->IsParallel( firstLine )
+                    || !secondLine->IsStrokeEquivalent( firstLine ) )
+            {
+                continue;
+            }
 
-            for( ++it2; it2 != lines.end(); ++it2 )
+            // Remove identical lines
+            if( firstLine->IsEndPoint( secondLine->GetStartPoint() )
+                    && firstLine->IsEndPoint( secondLine->GetEndPoint() ) )
             {
-                SCH_LINE* secondLine = *it2;
-                int       secondLeftXEdge = minX( secondLine );
+                remove_item( secondLine );
+                removedNeighbour = true;
+                continue;
+            }
 
-                // impossible to overlap remaining lines
-                if( secondLeftXEdge > firstRightXEdge )
-                    break;
+            // See if we can merge an overlap (or two colinear touching segments with
+            // no junction where they meet).
+            SCH_LINE* mergedLine = secondLine->MergeOverlap( aScreen, firstLine, true );
 
-                // No Y axis overlap
-                if( !( std::max( minY( firstLine ), minY( secondLine ) )
-                       <= std::min( maxY( firstLine ), maxY( secondLine ) ) ) )
-                {
-                    continue;
-                }
+            if( mergedLine != nullptr )
+            {
+                remove_item( firstLine );
+                remove_item( secondLine );
 
-                if( secondLine->GetFlags() & STRUCT_DELETED )
-                    continue;
+                AddToScreen( mergedLine, aScreen );
+                aCommit->Added( mergedLine, aScreen );
 
-                if( !secondLine->IsParallel( firstLine )
-                        || !secondLine->IsStrokeEquivalent( firstLine )
-                        || secondLine->GetLayer() != firstLine->GetLayer() )
-                {
-                    continue;
-                }
+                if( firstLine->IsSelected() || secondLine->IsSelected() )
+                    selectionTool->AddItemToSel( mergedLine, true /*quiet mode*/ );
 
-                // Remove identical lines
-                if( firstLine->IsEndPoint( secondLine->GetStartPoint() )
-                        && firstLine->IsEndPoint( secondLine->GetEndPoint() ) )
-                {
-                    remove_item( secondLine );
-                    continue;
-                }
-
-                // See if we can merge an overlap (or two colinear touching segments with
-                // no junction where they meet).
-                SCH_LINE* mergedLine = secondLine->MergeOverlap( aScreen, firstLine, true );
+                pending.push_back( mergedLine );
 
-                if( mergedLine != nullptr )
+                for( SCH_LINE* neighbour : neighbours )
                 {
-                    remove_item( firstLine );
-                    remove_item( secondLine );
-
-                    AddToScreen( mergedLine, aScreen );
-                    aCommit->Added( mergedLine, aScreen );
-
-                    if( firstLine->IsSelected() || secondLine->IsSelected() )
-                        selectionTool->AddItemToSel( mergedLine, true /*quiet mode*/ );
-
-                    break;
+                    if( !( neighbour->GetFlags() & STRUCT_DELETED ) )
+                        pending.push_back( neighbour );
                 }
+
+                break;
             }
         }
+
+        if( removedNeighbour && !( firstLine->GetFlags() & STRUCT_DELETED ) )
+            pending.push_back( firstLine );
     }
 }
 
@@ -24,6 +24,7 @@
 #include <future>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <core/profile.h>
 #include <core/kicad_algo.h>
 #include <common.h>
@@ -57,7 +58,7 @@
  * Flag to enable connectivity profiling
  * @ingroup trace_env_vars
  */
-static const wxChar DanglingProfileMask[] = wxT( "CONN_PROFILE" );
+const wxChar ConnProfileMask[] = wxT( "CONN_PROFILE" );
 
 
 /**
@@ -726,6 +727,10 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
 {
     PROF_TIMER recalc_time( "CONNECTION_GRAPH::Recalculate" );
 
+    // Some text variables (net names, intersheet references) depend on the connectivity
+    if( m_schematic )
+        m_schematic->InvalidateShownTextCache();
+
     if( aUnconditional )
         Reset();
 
@@ -733,9 +738,60 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
 
     m_sheetList = aSheetList;
     std::set<SCH_ITEM*> dirty_items;
+    size_t              updated_sheets = 0;
+
+    // After a local edit only the screens holding a changed item need their items scanned and
+    // their dangling ends tested again; doing so for every sheet is what made small edits slow
+    // in large hierarchies.
+    std::unordered_map<SCH_SCREEN*, bool> dirty_screens;
+
+    auto screenIsDirty =
+            [&]( SCH_SCREEN* aScreen ) -> bool
+            {
+                auto [it, inserted] = dirty_screens.emplace( aScreen, false );
+
+                if( !inserted )
+                    return it->second;
+
+                for( SCH_ITEM* item : aScreen->Items() )
+                {
+                    if( !item->IsConnectable() )
+                        continue;
+
+                    if( item->IsConnectivityDirty() )
+                        return it->second = true;
+
+                    if( item->Type() == SCH_SYMBOL_T )
+                    {
+                        for( const std::unique_ptr<SCH_PIN>& pin :
+                                static_cast<SCH_SYMBOL*>( item )->GetRawPins() )
+                        {
+                            if( pin->IsConnectivityDirty() )
+                                return it->second = true;
+                        }
+                    }
+                    else if( item->Type() == SCH_SHEET_T )
+                    {
+                        for( SCH_SHEET_PIN* pin : static_cast<SCH_SHEET*>( item )->GetPins() )
+                        {
+                            if( pin->IsConnectivityDirty() )
+                                return it->second = true;
+                        }
+                    }
+                }
+
+                return false;
+            };
+
+    m_screen_connectivity.clear();
 
     for( const SCH_SHEET_PATH& sheet : aSheetList )
     {
+        if( !aUnconditional && !screenIsDirty( sheet.LastScreen() ) )
+            continue;
+
+        updated_sheets++;
+
         std::vector<SCH_ITEM*> items;
 
         // Store current unit value, to replace it after calculations
@@ -820,6 +876,8 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
             symbol->SetUnit( originalUnit );
     }
 
+    m_screen_connectivity.clear();
+
     // Restore the danlging states of items in the current SCH_SCREEN to match the current
     // SCH_SHEET_PATH.
     m_schematic->CurrentSheet().LastScreen()->TestDanglingEnds( &m_schematic->CurrentSheet(),
@@ -828,19 +886,27 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
     for( SCH_ITEM* item : dirty_items )
         item->SetConnectivityDirty( false );
 
-    if( wxLog::IsAllowedTraceMask( DanglingProfileMask ) )
+    if( wxLog::IsAllowedTraceMask( ConnProfileMask ) )
+    {
         update_items.Show();
+        wxLogTrace( ConnProfileMask, wxT( "%s update: %zu of %zu sheets, %zu dirty items" ),
+                    aUnconditional ? wxT( "Full" ) : wxT( "Incremental" ), updated_sheets,
+                    aSheetList.size(), dirty_items.size() );
+    }
 
     PROF_TIMER build_graph( "buildConnectionGraph" );
 
     buildConnectionGraph( aChangedItemHandler, aUnconditional );
 
-    if( wxLog::IsAllowedTraceMask( DanglingProfileMask ) )
+    if( m_schematic )
+        m_schematic->InvalidateShownTextCache();
+
+    if( wxLog::IsAllowedTraceMask( ConnProfileMask ) )
         build_graph.Show();
 
     recalc_time.Stop();
 
-    if( wxLog::IsAllowedTraceMask( DanglingProfileMask ) )
+    if( wxLog::IsAllowedTraceMask( ConnProfileMask ) )
         recalc_time.Show();
 }
 
@@ -848,8 +914,10 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
 std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffectedItems(
         const std::set<SCH_ITEM*> &aItems )
 {
+    PROF_TIMER                                     timer;
     std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> retvals;
-    std::set<CONNECTION_SUBGRAPH*> subgraphs;
+    std::set<CONNECTION_SUBGRAPH*>                 subgraphs;
+    std::unordered_set<SCH_ITEM*>                  removed_items;
 
     auto traverse_subgraph = [&retvals, &subgraphs]( CONNECTION_SUBGRAPH* aSubgraph )
     {
@@ -886,6 +954,9 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
                         aItem->GetTypeDesc(), item_sg->m_code, item_sg );
         }
 
+        // All the subgraphs of the net (and the hierarchy and buses connected to them) are
+        // rebuilt, not only those whose driver changes: the rebuilt graph is merged back as whole
+        // nets, so a partial net would not match a full recalculation.
         std::vector<CONNECTION_SUBGRAPH*> sg_to_scan = GetAllSubgraphs( item_sg->GetNetName() );
 
         if( sg_to_scan.empty() )
@@ -919,7 +990,7 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
             }
         }
 
-        alg::delete_matching( m_items, aItem );
+        removed_items.insert( aItem );
     };
 
     for( SCH_ITEM* item : aItems )
@@ -947,7 +1018,17 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
     removeSubgraphs( subgraphs );
 
     for( const auto& [path, item] : retvals )
-        alg::delete_matching( m_items, item );
+        removed_items.insert( item );
+
+    alg::delete_if( m_items,
+                    [&removed_items]( SCH_ITEM* aItem )
+                    {
+                        return removed_items.count( aItem ) > 0;
+                    } );
+
+    wxLogTrace( ConnProfileMask, wxT( "ExtractAffectedItems: %zu changed items affect %zu "
+                                          "items in %zu subgraphs (%0.1f ms)" ),
+                aItems.size(), retvals.size(), subgraphs.size(), timer.msecs() );
 
     return retvals;
 }
@@ -974,15 +1055,8 @@ void CONNECTION_GRAPH::RemoveItem( SCH_ITEM* aItem )
 void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgraphs )
 {
     wxLogTrace( ConnTrace, wxT( "Removing %zu subgraphs" ), aSubgraphs.size() );
-    std::sort( m_driver_subgraphs.begin(), m_driver_subgraphs.end() );
-    std::sort( m_subgraphs.begin(), m_subgraphs.end() );
     std::set<int> codes_to_remove;
 
-    for( auto& el : m_sheet_to_subgraphs_map )
-    {
-        std::sort( el.second.begin(), el.second.end() );
-    }
-
     for( CONNECTION_SUBGRAPH* sg : aSubgraphs )
     {
         for( auto& it : sg->m_bus_neighbors )
@@ -1022,87 +1096,52 @@ void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgrap
                     parent->m_bus_neighbors.erase( it.first );
             }
         }
+    }
 
-        {
-            auto it = std::lower_bound( m_driver_subgraphs.begin(), m_driver_subgraphs.end(), sg );
-
-            while( it != m_driver_subgraphs.end() && *it == sg )
-                it = m_driver_subgraphs.erase( it );
-        }
-
-        {
-            auto it = std::lower_bound( m_subgraphs.begin(), m_subgraphs.end(), sg );
-
-            while( it != m_subgraphs.end() && *it == sg )
-                it = m_subgraphs.erase( it );
-        }
-
-        for( auto& el : m_sheet_to_subgraphs_map )
-        {
-            auto it = std::lower_bound( el.second.begin(), el.second.end(), sg );
-
-            while( it != el.second.end() && *it == sg )
-                it = el.second.erase( it );
-        }
-
-        auto remove_sg = [sg]( auto it ) -> bool
-                        {
-                            for( const CONNECTION_SUBGRAPH* test_sg : it->second )
-                            {
-                                if( sg == test_sg )
-                                    return true;
-                            }
+    // The maps below hold every subgraph of the schematic.  Walk each of them once rather than
+    // once per removed subgraph: a local edit in a large hierarchy removes a few subgraphs, but
+    // the maps have hundreds of thousands of entries.
+    auto isRemoved =
+            [&aSubgraphs]( const CONNECTION_SUBGRAPH* aSubgraph ) -> bool
+            {
+                return aSubgraphs.count( const_cast<CONNECTION_SUBGRAPH*>( aSubgraph ) ) > 0;
+            };
 
-                            return false;
-                        };
+    auto holdsRemoved =
+            [&isRemoved]( const auto& aEntry ) -> bool
+            {
+                return std::any_of( aEntry.second.begin(), aEntry.second.end(), isRemoved );
+            };
 
-        for( auto it = m_global_label_cache.begin(); it != m_global_label_cache.end(); )
-        {
-            if( remove_sg( it ) )
-                it = m_global_label_cache.erase( it );
-            else
-                ++it;
-        }
+    alg::delete_if( m_driver_subgraphs, isRemoved );
+    alg::delete_if( m_subgraphs, isRemoved );
 
-        for( auto it = m_local_label_cache.begin(); it != m_local_label_cache.end(); )
-        {
-            if( remove_sg( it ) )
-                it = m_local_label_cache.erase( it );
-            else
-                ++it;
-        }
+    for( auto& [sheet, subgraphs] : m_sheet_to_subgraphs_map )
+        alg::delete_if( subgraphs, isRemoved );
 
-        for( auto it = m_net_code_to_subgraphs_map.begin();
-             it != m_net_code_to_subgraphs_map.end(); )
-        {
-            if( remove_sg( it ) )
-            {
-                codes_to_remove.insert( it->first.Netcode );
-                it = m_net_code_to_subgraphs_map.erase( it );
-            }
-            else
-                ++it;
-        }
+    std::erase_if( m_global_label_cache, holdsRemoved );
+    std::erase_if( m_local_label_cache, holdsRemoved );
 
-        for( auto it = m_net_name_to_subgraphs_map.begin();
-             it != m_net_name_to_subgraphs_map.end(); )
+    for( auto it = m_net_code_to_subgraphs_map.begin(); it != m_net_code_to_subgraphs_map.end(); )
+    {
+        if( holdsRemoved( *it ) )
         {
-            if( remove_sg( it ) )
-                it = m_net_name_to_subgraphs_map.erase( it );
-            else
-                ++it;
+            codes_to_remove.insert( it->first.Netcode );
+            it = m_net_code_to_subgraphs_map.erase( it );
         }
-
-        for( auto it = m_item_to_subgraph_map.begin(); it != m_item_to_subgraph_map.end(); )
+        else
         {
-            if( it->second == sg )
-                it = m_item_to_subgraph_map.erase( it );
-            else
-                ++it;
+            ++it;
         }
+    }
 
+    std::erase_if( m_net_name_to_subgraphs_map, holdsRemoved );
 
-    }
+    std::erase_if( m_item_to_subgraph_map,
+                   [&isRemoved]( const auto& aEntry )
+                   {
+                       return isRemoved( aEntry.second );
+                   } );
 
     for( auto it = m_net_name_to_code_map.begin(); it != m_net_name_to_code_map.end(); )
     {
@@ -1136,6 +1175,10 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                 aSheet.Last()->GetFileName(), aItemList.size() );
     std::map<VECTOR2I, std::vector<SCH_ITEM*>> connection_map;
 
+    // The items which get linked, in the order they are found
+    std::vector<SCH_ITEM*> connectables;
+    std::vector<SCH_ITEM*> busEntries;
+
     auto updatePin = [&]( SCH_PIN* aPin, SCH_CONNECTION* aConn )
     {
         aConn->SetType( CONNECTION_TYPE::NET );
@@ -1166,6 +1209,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                 pin->ClearConnectedItems( aSheet );
 
                 connection_map[ pin->GetTextPos() ].push_back( pin );
+                connectables.push_back( pin );
                 m_items.emplace_back( pin );
             }
         }
@@ -1179,6 +1223,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                 SCH_CONNECTION* conn = pin->InitializeConnection( aSheet, this );
                 updatePin( pin, conn );
                 connection_map[ pin->GetPosition() ].push_back( pin );
+                connectables.push_back( pin );
             }
         }
         else
@@ -1196,10 +1241,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
 
             case SCH_BUS_BUS_ENTRY_T:
                 conn->SetType( CONNECTION_TYPE::BUS );
-
-                // clean previous (old) links:
-                static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[0] = nullptr;
-                static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[1] = nullptr;
+                busEntries.push_back( item );
                 break;
 
             case SCH_PIN_T:
@@ -1211,9 +1253,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
 
             case SCH_BUS_WIRE_ENTRY_T:
                 conn->SetType( CONNECTION_TYPE::NET );
-
-                // clean previous (old) link:
-                static_cast<SCH_BUS_WIRE_ENTRY*>( item )->m_connected_bus_item = nullptr;
+                busEntries.push_back( item );
                 break;
 
             default:
@@ -1222,6 +1262,42 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
 
             for( const VECTOR2I& point : points )
                 connection_map[ point ].push_back( item );
+
+            connectables.push_back( item );
+        }
+    }
+
+    // The items of a screen connect the same way in all the instances of its sheet, so the
+    // links found for the first instance are reused for the others (unless they have a
+    // different set of pins, because of a different unit selection).
+    auto [ screenIt, firstInstance ] =
+            m_screen_connectivity.try_emplace( aSheet.LastScreen() );
+    SCREEN_CONNECTIVITY& screenConn = screenIt->second;
+
+    if( m_reuseScreenLinks && !firstInstance && screenConn.m_items == connectables )
+    {
+        for( const auto& [ item, connectedItem ] : screenConn.m_links )
+            item->AddConnectionTo( aSheet, connectedItem );
+
+        return;
+    }
+
+    bool recordLinks = m_reuseScreenLinks && firstInstance;
+
+    if( recordLinks )
+        screenConn.m_items = connectables;
+
+    // The bus entry links are stored in the items, not per sheet: clean the previous (old) ones
+    for( SCH_ITEM* item : busEntries )
+    {
+        if( item->Type() == SCH_BUS_BUS_ENTRY_T )
+        {
+            static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[0] = nullptr;
+            static_cast<SCH_BUS_BUS_ENTRY*>( item )->m_connected_bus_items[1] = nullptr;
+        }
+        else
+        {
+            static_cast<SCH_BUS_WIRE_ENTRY*>( item )->m_connected_bus_item = nullptr;
         }
     }
 
@@ -1236,7 +1312,10 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
 
         std::mutex update_mutex;
 
-        auto update_lambda = [&]( SCH_ITEM* connected_item ) -> size_t
+        // Links made by each item of connection_vec, for the screen connectivity
+        std::vector<std::vector<SCH_ITEM*>> links( recordLinks ? connection_vec.size() : 0 );
+
+        auto update_lambda = [&]( SCH_ITEM* connected_item, size_t aIndex ) -> size_t
         {
             // Bus entries are special: they can have connection points in the
             // middle of a wire segment, because the junction algo doesn't split
@@ -1277,6 +1356,12 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                         std::lock_guard<std::mutex> lock( update_mutex );
                         bus_entry->AddConnectionTo( aSheet, busLine );
                         busLine->AddConnectionTo( aSheet, bus_entry );
+
+                        if( recordLinks )
+                        {
+                            screenConn.m_links.emplace_back( bus_entry, busLine );
+                            screenConn.m_links.emplace_back( busLine, bus_entry );
+                        }
                     }
                 }
             }
@@ -1321,6 +1406,9 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                     bus_connection_ok )
                 {
                     connected_item->AddConnectionTo( aSheet, test_item );
+
+                    if( recordLinks )
+                        links[aIndex].push_back( test_item );
                 }
             }
 
@@ -1350,9 +1438,15 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                 [&]( const int a, const int b)
                 {
                     for( int ii = a; ii < b; ++ii )
-                        update_lambda( connection_vec[ii] );
+                        update_lambda( connection_vec[ii], ii );
                 });
         tp.wait_for_tasks();
+
+        for( size_t ii = 0; ii < links.size(); ++ii )
+        {
+            for( SCH_ITEM* connectedItem : links[ii] )
+                screenConn.m_links.emplace_back( connection_vec[ii], connectedItem );
+        }
     }
 }
 
@@ -2092,7 +2186,7 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
     PROF_TIMER sub_graph( "buildItemSubGraphs" );
     buildItemSubGraphs();
 
-    if( wxLog::IsAllowedTraceMask( DanglingProfileMask ) )
+    if( wxLog::IsAllowedTraceMask( ConnProfileMask ) )
         sub_graph.Show();
 
 
@@ -2101,6 +2195,8 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
      * anything. We should consider removing them entirely and just using net names everywhere.
      */
 
+    PROF_TIMER resolve_drivers( "resolveAllDrivers" );
+
     resolveAllDrivers();
 
     collectAllDriverValues();
@@ -2109,10 +2205,13 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
 
     generateBusAliasMembers();
 
+    if( wxLog::IsAllowedTraceMask( ConnProfileMask ) )
+        resolve_drivers.Show();
+
     PROF_TIMER proc_sub_graph( "ProcessSubGraphs" );
     processSubGraphs();
 
-    if( wxLog::IsAllowedTraceMask( DanglingProfileMask ) )
+    if( wxLog::IsAllowedTraceMask( ConnProfileMask ) )
         proc_sub_graph.Show();
 
     // Absorbed subgraphs should no longer be considered
@@ -2146,6 +2245,8 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
             });
     tp.wait_for_tasks();
 
+    PROF_TIMER propagate( "propagateToNeighbors" );
+
     // Next time through the subgraphs, we do some post-processing to handle things like
     // connecting bus members to their neighboring subgraphs, and then propagate connections
     // through the hierarchy
@@ -2215,6 +2316,13 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
             propagateToNeighbors( subgraph, true );
     }
 
+    if( wxLog::IsAllowedTraceMask( ConnProfileMask ) )
+    {
+        propagate.Show();
+        wxLogTrace( ConnProfileMask, wxT( "%zu subgraphs, %zu driver subgraphs" ),
+                    m_subgraphs.size(), m_driver_subgraphs.size() );
+    }
+
     // Handle buses that have been linked together somewhere by member (net) connections.
     // This feels a bit hacky, perhaps this algorithm should be revisited in the future.
 
@@ -44,9 +44,17 @@ class SCHEMATIC;
 class SCH_EDIT_FRAME;
 class SCH_HIERLABEL;
 class SCH_PIN;
+class SCH_SCREEN;
 class SCH_SHEET_PIN;
 
 
+/**
+ * Flag to enable connectivity profiling
+ * @ingroup trace_env_vars
+ */
+extern const wxChar ConnProfileMask[];
+
+
 /**
  * A subgraph is a set of items that are electrically connected on a single sheet.
  *
@@ -353,7 +361,8 @@ public:
               m_last_net_code( 1 ),
               m_last_bus_code( 1 ),
               m_last_subgraph_code( 1 ),
-              m_schematic( aSchematic )
+              m_schematic( aSchematic ),
+              m_reuseScreenLinks( true )
     {}
 
     ~CONNECTION_GRAPH()
@@ -375,6 +384,13 @@ public:
         m_last_subgraph_code = aOther->m_last_subgraph_code;
     }
 
+    /**
+     * Set whether the item links found in the first instance of a screen are replayed for
+     * its other sheet instances (the default), or searched again for each of them.  Only
+     * meant to compare both, the resulting connectivity is the same.
+     */
+    void SetReuseScreenLinks( bool aReuse ) { m_reuseScreenLinks = aReuse; }
+
     /**
      * Update the connection graph for the given list of sheets.
      *
@@ -449,6 +465,10 @@ public:
      * For a set of items, this will remove the connected items and their
      * associated data including subgraphs and generated codes from the connection graph.
      *
+     * Every subgraph of the nets of the input items is removed, along with the hierarchy and
+     * bus members reachable from them, whether or not their drivers change: the graph rebuilt
+     * from the returned items is merged back as whole nets.
+     *
      * @param aItems A vector of items whose presence should be removed from the graph.
      * @return The full set of all items associated with the input items that were removed.
      */
@@ -509,6 +529,9 @@ private:
      *
      * As a side effect, items are loaded into m_items for BuildConnectionGraph().
      *
+     * The links found for the first instance of a screen are kept in #m_screen_connectivity
+     * and replayed for its other instances, so a sheet used many times is only searched once.
+     *
      * @param aSheet is the path to the sheet of all items in the list.
      * @param aItemList is a list of items to consider.
      */
@@ -742,6 +765,16 @@ private:
 
 
 private:
+    /**
+     * The links between the items of a screen, found while updating the connectivity of the
+     * first sheet instance using it.
+     */
+    struct SCREEN_CONNECTIVITY
+    {
+        std::vector<SCH_ITEM*>                       m_items;  ///< Items (and pins) linked
+        std::vector<std::pair<SCH_ITEM*, SCH_ITEM*>> m_links;
+    };
+
     /// All the sheets in the schematic (as long as we don't have partial updates).
     SCH_SHEET_LIST m_sheetList;
 
@@ -774,6 +807,9 @@ private:
 
     std::unordered_map<SCH_ITEM*, CONNECTION_SUBGRAPH*> m_item_to_subgraph_map;
 
+    /// Item links of the screens updated by the running Recalculate().
+    std::unordered_map<SCH_SCREEN*, SCREEN_CONNECTIVITY> m_screen_connectivity;
+
     NET_MAP m_net_code_to_subgraphs_map;
 
     int m_last_net_code;
@@ -783,6 +819,8 @@ private:
     int m_last_subgraph_code;
 
     SCHEMATIC* m_schematic;     ///< The schematic this graph represents.
+
+    bool m_reuseScreenLinks;    ///< See SetReuseScreenLinks().
 };
 
 #endif
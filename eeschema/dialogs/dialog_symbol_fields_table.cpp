@@ -933,7 +933,7 @@ void DIALOG_SYMBOL_FIELDS_TABLE::OnColSort( wxGridEvent& aEvent )
     }
 
     m_dataModel->SetSorting( sortCol, ascending );
-    m_dataModel->RebuildRows();
+    m_dataModel->SortRows();
     m_grid->ForceRefresh();
 
     syncBomPresetSelection();
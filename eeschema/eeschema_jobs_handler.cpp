@@ -20,6 +20,7 @@
 
 #include "eeschema_jobs_handler.h"
 #include <common.h>
+#include <core/thread_pool.h>
 #include <pgm_base.h>
 #include <cli/exit_codes.h>
 #include <sch_plotter.h>
@@ -280,6 +281,7 @@ int EESCHEMA_JOBS_HANDLER::JobExportNetlist( JOB* aJob )
     if( erc.TestDuplicateSheetNames( false ) > 0 )
         m_reporter->Report( _( "Warning: duplicate sheet names.\n" ), RPT_SEVERITY_WARNING );
 
+    SHOWN_TEXT_CACHE_ENABLER               shownTextCache( sch );
     std::unique_ptr<NETLIST_EXPORTER_BASE> helper;
     unsigned netlistOption = 0;
 
@@ -397,6 +399,32 @@ int EESCHEMA_JOBS_HANDLER::JobExportBom( JOB* aJob )
     if( erc.TestDuplicateSheetNames( false ) > 0 )
         m_reporter->Report( _( "Warning: duplicate sheet names.\n" ), RPT_SEVERITY_WARNING );
 
+    SHOWN_TEXT_CACHE_ENABLER shownTextCache( sch );
+
+    // Expanding field text variables is the costliest part of a BOM.  Do it for all the sheets
+    // in parallel up front; the data model then finds the values in the shown text cache, for
+    // every preset exported below.
+    {
+        SCH_SHEET_LIST sheetList = sch->BuildUnorderedSheetList();
+
+        ParallelForEach( sheetList.size(),
+                [&]( size_t aIndex )
+                {
+                    const SCH_SHEET_PATH& path = sheetList[aIndex];
+
+                    for( SCH_ITEM* item : path.LastScreen()->Items().OfType( SCH_SYMBOL_T ) )
+                    {
+                        SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+
+                        if( symbol->IsPower() )
+                            continue;
+
+                        for( const SCH_FIELD& field : symbol->GetFields() )
+                            field.GetShownText( &path, false );
+                    }
+                } );
+    }
+
     // Build our data model
     FIELDS_EDITOR_GRID_DATA_MODEL dataModel( referenceList );
 
@@ -430,41 +458,58 @@ int EESCHEMA_JOBS_HANDLER::JobExportBom( JOB* aJob )
         }
     }
 
-    BOM_PRESET preset;
+    // In batch mode every preset is exported with every format preset, each to its own file
+    std::vector<wxString> presetNames = aBomJob->m_bomPresetNames;
+    std::vector<wxString> fmtPresetNames = aBomJob->m_bomFmtPresetNames;
+    bool                  presetBatch = !presetNames.empty();
+    bool                  fmtPresetBatch = !fmtPresetNames.empty();
+
+    if( !presetBatch && !aBomJob->m_bomPresetName.IsEmpty() )
+        presetNames.push_back( aBomJob->m_bomPresetName );
+
+    if( !fmtPresetBatch && !aBomJob->m_bomFmtPresetName.IsEmpty() )
+        fmtPresetNames.push_back( aBomJob->m_bomFmtPresetName );
 
-    // Load a preset if one is specified
-    if( !aBomJob->m_bomPresetName.IsEmpty() )
+    std::vector<BOM_PRESET> presets;
+
+    // Load the presets if any are specified
+    if( !presetNames.empty() )
     {
         // Make sure the built-in presets are loaded
         for( const BOM_PRESET& p : BOM_PRESET::BuiltInPresets() )
             sch->Settings().m_BomPresets.emplace_back( p );
 
-        // Find the preset
-        BOM_PRESET* schPreset = nullptr;
-
-        for( BOM_PRESET& p : sch->Settings().m_BomPresets )
+        for( const wxString& presetName : presetNames )
         {
-            if( p.name == aBomJob->m_bomPresetName )
+            // Find the preset
+            BOM_PRESET* schPreset = nullptr;
+
+            for( BOM_PRESET& p : sch->Settings().m_BomPresets )
             {
-                schPreset = &p;
-                break;
+                if( p.name == presetName )
+                {
+                    schPreset = &p;
+                    break;
+                }
             }
-        }
 
-        if( !schPreset )
-        {
-            m_reporter->Report( wxString::Format( _( "BOM preset '%s' not found" ) + wxS( "\n" ),
-                                                  aBomJob->m_bomPresetName ),
-                    RPT_SEVERITY_ERROR );
+            if( !schPreset )
+            {
+                m_reporter->Report( wxString::Format( _( "BOM preset '%s' not found" )
+                                                              + wxS( "\n" ),
+                                                      presetName ),
+                                    RPT_SEVERITY_ERROR );
 
-            return CLI::EXIT_CODES::ERR_UNKNOWN;
-        }
+                return CLI::EXIT_CODES::ERR_UNKNOWN;
+            }
 
-        preset = *schPreset;
+            presets.push_back( *schPreset );
+        }
     }
     else
     {
-        size_t i = 0;
+        BOM_PRESET preset;
+        size_t     i = 0;
 
         for( wxString fieldName : aBomJob->m_fieldsOrdered )
         {
@@ -533,77 +578,130 @@ int EESCHEMA_JOBS_HANDLER::JobExportBom( JOB* aJob )
         preset.groupSymbols = ( aBomJob->m_fieldsGroupBy.size() > 0 );
         preset.excludeDNP = aBomJob->m_excludeDNP;
         preset.includeExcludedFromBOM = aBomJob->m_includeExcludedFromBOM;
-    }
-
-    dataModel.ApplyBomPreset( preset );
 
-    if( aBomJob->m_outputFile.IsEmpty() )
-    {
-        wxFileName fn = sch->GetFileName();
-        fn.SetName( fn.GetName() );
-        fn.SetExt( FILEEXT::CsvFileExtension );
-
-        aBomJob->m_outputFile = fn.GetFullName();
+        presets.push_back( preset );
     }
 
-    wxFile f;
+    std::vector<BOM_FMT_PRESET> fmts;
 
-    if( !f.Open( aBomJob->m_outputFile, wxFile::write ) )
-    {
-        m_reporter->Report( wxString::Format( _( "Unable to open destination '%s'" ),
-                                              aBomJob->m_outputFile ),
-                            RPT_SEVERITY_ERROR );
-
-        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
-    }
-
-    BOM_FMT_PRESET fmt;
-
-    // Load a format preset if one is specified
-    if( !aBomJob->m_bomFmtPresetName.IsEmpty() )
+    // Load the format presets if any are specified
+    if( !fmtPresetNames.empty() )
     {
         // Make sure the built-in presets are loaded
         for( const BOM_FMT_PRESET& p : BOM_FMT_PRESET::BuiltInPresets() )
             sch->Settings().m_BomFmtPresets.emplace_back( p );
 
-        // Find the preset
-        BOM_FMT_PRESET* schFmtPreset = nullptr;
-
-        for( BOM_FMT_PRESET& p : sch->Settings().m_BomFmtPresets )
+        for( const wxString& fmtPresetName : fmtPresetNames )
         {
-            if( p.name == aBomJob->m_bomFmtPresetName )
+            // Find the preset
+            BOM_FMT_PRESET* schFmtPreset = nullptr;
+
+            for( BOM_FMT_PRESET& p : sch->Settings().m_BomFmtPresets )
             {
-                schFmtPreset = &p;
-                break;
+                if( p.name == fmtPresetName )
+                {
+                    schFmtPreset = &p;
+                    break;
+                }
             }
-        }
 
-        if( !schFmtPreset )
-        {
-            m_reporter->Report(
-                    wxString::Format( _( "BOM format preset '%s' not found" ) + wxS( "\n" ),
-                                                  aBomJob->m_bomFmtPresetName ),
-                                RPT_SEVERITY_ERROR );
+            if( !schFmtPreset )
+            {
+                m_reporter->Report( wxString::Format( _( "BOM format preset '%s' not found" )
+                                                              + wxS( "\n" ),
+                                                      fmtPresetName ),
+                                    RPT_SEVERITY_ERROR );
 
-            return CLI::EXIT_CODES::ERR_UNKNOWN;
-        }
+                return CLI::EXIT_CODES::ERR_UNKNOWN;
+            }
 
-        fmt = *schFmtPreset;
+            fmts.push_back( *schFmtPreset );
+        }
     }
     else
     {
+        BOM_FMT_PRESET fmt;
+
         fmt.fieldDelimiter = aBomJob->m_fieldDelimiter;
         fmt.stringDelimiter = aBomJob->m_stringDelimiter;
         fmt.refDelimiter = aBomJob->m_refDelimiter;
         fmt.refRangeDelimiter = aBomJob->m_refRangeDelimiter;
         fmt.keepTabs = aBomJob->m_keepTabs;
         fmt.keepLineBreaks = aBomJob->m_keepLineBreaks;
+
+        fmts.push_back( fmt );
+    }
+
+    if( aBomJob->m_outputFile.IsEmpty() )
+    {
+        wxFileName fn = sch->GetFileName();
+        fn.SetName( fn.GetName() );
+        fn.SetExt( FILEEXT::CsvFileExtension );
+
+        aBomJob->m_outputFile = fn.GetFullName();
     }
 
-    bool res = f.Write( dataModel.Export( fmt ) );
+    // In batch mode the output file is the base name of the files, or the directory to put them
+    // in.  The preset names are appended to it.
+    auto getOutputFile =
+            [&]( const BOM_PRESET& aPreset, const BOM_FMT_PRESET& aFmt ) -> wxString
+            {
+                if( !presetBatch && !fmtPresetBatch )
+                    return aBomJob->m_outputFile;
 
-    if( !res )
-        return CLI::EXIT_CODES::ERR_UNKNOWN;
+                wxFileName fn( aBomJob->m_outputFile );
+
+                if( wxDir::Exists( aBomJob->m_outputFile ) )
+                {
+                    fn.AssignDir( aBomJob->m_outputFile );
+                    fn.SetName( wxFileName( sch->GetFileName() ).GetName() );
+                    fn.SetExt( FILEEXT::CsvFileExtension );
+                }
+
+                wxString suffix;
+
+                if( presetBatch )
+                    suffix += wxS( "-" ) + aPreset.name;
+
+                if( fmtPresetBatch )
+                    suffix += wxS( "-" ) + aFmt.name;
+
+                ReplaceIllegalFileNameChars( suffix, '_' );
+                suffix.Replace( wxS( " " ), wxS( "_" ) );
+
+                fn.SetName( fn.GetName() + suffix );
+
+                return fn.GetFullPath();
+            };
+
+    for( const BOM_PRESET& preset : presets )
+    {
+        dataModel.ApplyBomPreset( preset );
+
+        for( const BOM_FMT_PRESET& fmt : fmts )
+        {
+            wxString outputFile = getOutputFile( preset, fmt );
+            wxFile   f;
+
+            if( !f.Open( outputFile, wxFile::write ) )
+            {
+                m_reporter->Report( wxString::Format( _( "Unable to open destination '%s'" ),
+                                                      outputFile ),
+                                    RPT_SEVERITY_ERROR );
+
+                return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+            }
+
+            if( presetBatch || fmtPresetBatch )
+            {
+                m_reporter->Report( wxString::Format( _( "Exporting BOM to '%s'\n" ), outputFile ),
+                                    RPT_SEVERITY_ACTION );
+            }
+
+            if( !f.Write( dataModel.Export( fmt ) ) )
+                return CLI::EXIT_CODES::ERR_UNKNOWN;
+        }
+    }
 
     return CLI::EXIT_CODES::OK;
 }
@@ -54,6 +54,7 @@
 #include <sim/sim_lib_mgr.h>
 #include <progress_reporter.h>
 #include <kiway.h>
+#include <core/thread_pool.h>
 
 
 /* ERC tests :
@@ -703,10 +704,9 @@ int ERC_TESTER::TestMissingNetclasses()
 
 int ERC_TESTER::TestLabelMultipleWires()
 {
-    int err_count = 0;
-
-    for( const SCH_SHEET_PATH& sheet : m_sheetList )
+    auto testSheet = [&]( size_t aSheet, std::vector<PENDING_MARKER>& aMarkers )
     {
+        const SCH_SHEET_PATH&                      sheet = m_sheetList[aSheet];
         std::map<VECTOR2I, std::vector<SCH_ITEM*>> connMap;
 
         for( SCH_ITEM* item : sheet.LastScreen()->Items().OfType( SCH_LABEL_T ) )
@@ -735,7 +735,6 @@ int ERC_TESTER::TestLabelMultipleWires()
 
             if( lines.size() > 1 )
             {
-                err_count++;
                 lines.resize( 3 ); // Only show the first 3 lines and if there are only two, adds a nullptr
 
                 std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_LABEL_MULTIPLE_WIRES );
@@ -746,22 +745,20 @@ int ERC_TESTER::TestLabelMultipleWires()
                 ercItem->SetErrorMessage( msg );
                 ercItem->SetSheetSpecificPath( sheet );
 
-                SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                aMarkers.push_back( { ercItem, pair.first, sheet.LastScreen() } );
             }
         }
-    }
+    };
 
-    return err_count;
+    return runParallel( m_sheetList.size(), testSheet );
 }
 
 
 int ERC_TESTER::TestFourWayJunction()
 {
-    int err_count = 0;
-
-    for( const SCH_SHEET_PATH& sheet : m_sheetList )
+    auto testSheet = [&]( size_t aSheet, std::vector<PENDING_MARKER>& aMarkers )
     {
+        const SCH_SHEET_PATH&                      sheet = m_sheetList[aSheet];
         std::map<VECTOR2I, std::vector<SCH_ITEM*>> connMap;
         SCH_SCREEN* screen = sheet.LastScreen();
 
@@ -788,8 +785,6 @@ int ERC_TESTER::TestFourWayJunction()
         {
             if( pair.second.size() >= 4 )
             {
-                err_count++;
-
                 std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_FOUR_WAY_JUNCTION );
 
                 ercItem->SetItems( pair.second[0], pair.second[1], pair.second[2], pair.second[3] );
@@ -800,22 +795,20 @@ int ERC_TESTER::TestFourWayJunction()
 
                 ercItem->SetSheetSpecificPath( sheet );
 
-                SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                aMarkers.push_back( { ercItem, pair.first, screen } );
             }
         }
-    }
+    };
 
-    return err_count;
+    return runParallel( m_sheetList.size(), testSheet );
 }
 
 
 int ERC_TESTER::TestNoConnectPins()
 {
-    int err_count = 0;
-
-    for( const SCH_SHEET_PATH& sheet : m_sheetList )
+    auto testSheet = [&]( size_t aSheet, std::vector<PENDING_MARKER>& aMarkers )
     {
+        const SCH_SHEET_PATH&                      sheet = m_sheetList[aSheet];
         std::map<VECTOR2I, std::vector<SCH_ITEM*>> pinMap;
 
         auto addOther =
@@ -859,8 +852,6 @@ int ERC_TESTER::TestNoConnectPins()
         {
             if( pair.second.size() > 1 )
             {
-                err_count++;
-
                 std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_NOCONNECT_CONNECTED );
 
                 ercItem->SetItems( pair.second[0], pair.second[1],
@@ -869,27 +860,29 @@ int ERC_TESTER::TestNoConnectPins()
                 ercItem->SetErrorMessage( _( "Pin with 'no connection' type is connected" ) );
                 ercItem->SetSheetSpecificPath( sheet );
 
-                SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                aMarkers.push_back( { ercItem, pair.first, sheet.LastScreen() } );
             }
         }
-    }
+    };
 
-    return err_count;
+    return runParallel( m_sheetList.size(), testSheet );
 }
 
 
 int ERC_TESTER::TestPinToPin()
 {
-    int errors = 0;
+    std::vector<const std::vector<CONNECTION_SUBGRAPH*>*> nets;
 
-    for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : m_nets )
+    for( const auto& [key, subgraphs] : m_nets )
+        nets.push_back( &subgraphs );
+
+    auto testNet = [&]( size_t aNet, std::vector<PENDING_MARKER>& aMarkers )
     {
         std::vector<ERC_SCH_PIN_CONTEXT>           pins;
         std::unordered_map<EDA_ITEM*, SCH_SCREEN*> pinToScreenMap;
         bool has_noconnect = false;
 
-        for( CONNECTION_SUBGRAPH* subgraph: net.second )
+        for( CONNECTION_SUBGRAPH* subgraph : *nets[aNet] )
         {
             if( subgraph->GetNoConnect() )
                 has_noconnect = true;
@@ -995,9 +988,8 @@ int ERC_TESTER::TestPinToPin()
                                               ElectricalPinTypeGetText( refType ),
                                               ElectricalPinTypeGetText( testType ) ) );
 
-                    SCH_MARKER* marker = new SCH_MARKER( ercItem, refPin.Pin()->GetPosition() );
-                    pinToScreenMap[refPin.Pin()]->Append( marker );
-                    errors++;
+                    aMarkers.push_back( { ercItem, refPin.Pin()->GetPosition(),
+                                          pinToScreenMap[refPin.Pin()] } );
                 }
             }
         }
@@ -1014,14 +1006,17 @@ int ERC_TESTER::TestPinToPin()
                 ercItem->SetSheetSpecificPath( needsDriver.Sheet() );
                 ercItem->SetItemsSheetPaths( needsDriver.Sheet() );
 
-                SCH_MARKER* marker = new SCH_MARKER( ercItem, needsDriver.Pin()->GetPosition() );
-                pinToScreenMap[needsDriver.Pin()]->Append( marker );
-                errors++;
+                aMarkers.push_back( { ercItem, needsDriver.Pin()->GetPosition(),
+                                      pinToScreenMap[needsDriver.Pin()] } );
             }
         }
-    }
+    };
 
-    return errors;
+    // The pin type names are built on first use, which isn't thread-safe: build them before
+    // the workers need them.
+    ElectricalPinTypeGetText( ELECTRICAL_PINTYPE::PT_INPUT );
+
+    return runParallel( nets.size(), testNet );
 }
 
 
@@ -1444,12 +1439,15 @@ int ERC_TESTER::TestFootprintLinkIssues( KIFACE* aCvPcb, PROJECT* aProject )
 
 int ERC_TESTER::TestOffGridEndpoints()
 {
-    const int gridSize = m_schematic->Settings().m_ConnectionGridSize;
-    int       err_count = 0;
+    const int                gridSize = m_schematic->Settings().m_ConnectionGridSize;
+    std::vector<SCH_SCREEN*> screens;
 
     for( SCH_SCREEN* screen = m_screens.GetFirst(); screen; screen = m_screens.GetNext() )
+        screens.push_back( screen );
+
+    auto testScreen = [&]( size_t aScreen, std::vector<PENDING_MARKER>& aMarkers )
     {
-        std::vector<SCH_MARKER*> markers;
+        SCH_SCREEN* screen = screens[aScreen];
 
         for( SCH_ITEM* item : screen->Items() )
         {
@@ -1463,7 +1461,7 @@ int ERC_TESTER::TestOffGridEndpoints()
                     std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_ENDPOINT_OFF_GRID );
                     ercItem->SetItems( line );
 
-                    markers.emplace_back( new SCH_MARKER( ercItem, line->GetStartPoint() ) );
+                    aMarkers.push_back( { ercItem, line->GetStartPoint(), screen } );
                 }
                 else if( ( line->GetEndPoint().x % gridSize ) != 0
                             || ( line->GetEndPoint().y % gridSize ) != 0 )
@@ -1471,7 +1469,7 @@ int ERC_TESTER::TestOffGridEndpoints()
                     std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_ENDPOINT_OFF_GRID );
                     ercItem->SetItems( line );
 
-                    markers.emplace_back( new SCH_MARKER( ercItem, line->GetEndPoint() ) );
+                    aMarkers.push_back( { ercItem, line->GetEndPoint(), screen } );
                 }
             }
             else if( item->Type() == SCH_SYMBOL_T )
@@ -1487,21 +1485,15 @@ int ERC_TESTER::TestOffGridEndpoints()
                         auto ercItem = ERC_ITEM::Create( ERCE_ENDPOINT_OFF_GRID );
                         ercItem->SetItems( pin );
 
-                        markers.emplace_back( new SCH_MARKER( ercItem, pinPos ) );
+                        aMarkers.push_back( { ercItem, pinPos, screen } );
                         break;
                     }
                 }
             }
         }
+    };
 
-        for( SCH_MARKER* marker : markers )
-        {
-            screen->Append( marker );
-            err_count += 1;
-        }
-    }
-
-    return err_count;
+    return runParallel( screens.size(), testScreen );
 }
 
 
@@ -1558,9 +1550,47 @@ int ERC_TESTER::TestSimModelIssues()
 }
 
 
+int ERC_TESTER::runParallel( size_t aCount,
+                             const std::function<void( size_t, std::vector<PENDING_MARKER>& )>& aTest )
+{
+    std::vector<std::vector<PENDING_MARKER>> results( aCount );
+
+    if( aCount )
+    {
+        thread_pool& tp = GetKiCadThreadPool();
+        auto         returns = tp.parallelize_loop( 0, aCount,
+                [&]( const int a, const int b )
+                {
+                    for( int ii = a; ii < b; ++ii )
+                        aTest( ii, results[ii] );
+                } );
+
+        for( size_t ii = 0; ii < returns.size(); ++ii )
+            returns[ii].wait();
+    }
+
+    // Markers are created here, on the calling thread and in index order, so they come out in
+    // the same order as a serial run.
+    int count = 0;
+
+    for( std::vector<PENDING_MARKER>& markers : results )
+    {
+        for( PENDING_MARKER& pending : markers )
+        {
+            pending.m_screen->Append( new SCH_MARKER( pending.m_item, pending.m_pos ) );
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
 void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aEditFrame,
                            KIFACE* aCvPcb, PROJECT* aProject, PROGRESS_REPORTER* aProgressReporter )
 {
+    SHOWN_TEXT_CACHE_ENABLER shownTextCache( m_schematic );
+
     m_sheetList.AnnotatePowerSymbols();
 
     // Test duplicate sheet names inside a given sheet.  While one can have multiple references
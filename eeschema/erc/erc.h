@@ -31,8 +31,10 @@
 #include <sch_screen.h>
 #include <sch_reference_list.h>
 #include <connection_graph.h>
-#include <vector>
+#include <functional>
 #include <map>
+#include <memory>
+#include <vector>
 
 
 class SCHEMATIC;
@@ -42,6 +44,7 @@ class PROGRESS_REPORTER;
 struct KIFACE;
 class PROJECT;
 class SCH_RULE_AREA;
+class ERC_ITEM;
 
 
 extern const wxString CommentERC_H[];
@@ -177,6 +180,25 @@ public:
                    KIFACE* aCvPcb, PROJECT* aProject, PROGRESS_REPORTER* aProgressReporter );
 
 private:
+    /// An issue found by a test running on the thread pool.  The marker itself is created once
+    /// the test is done.
+    struct PENDING_MARKER
+    {
+        std::shared_ptr<ERC_ITEM> m_item;
+        VECTOR2I                  m_pos;
+        SCH_SCREEN*               m_screen;
+    };
+
+    /**
+     * Run \a aTest on the thread pool for each index from 0 to \a aCount - 1 (a net, a sheet or
+     * a screen), then add the markers found to their screens in index order, so the result does
+     * not depend on the thread scheduling.
+     *
+     * @return the number of markers added.
+     */
+    int runParallel( size_t aCount,
+                     const std::function<void( size_t, std::vector<PENDING_MARKER>& )>& aTest );
+
     SCHEMATIC*                   m_schematic;
     ERC_SETTINGS&                m_settings;
     SCH_SHEET_LIST               m_sheetList;
@@ -28,6 +28,8 @@
 
 #include "fields_data_model.h"
 
+#include <unordered_map>
+
 
 const wxString FIELDS_EDITOR_GRID_DATA_MODEL::QUANTITY_VARIABLE = wxS( "${QUANTITY}" );
 const wxString FIELDS_EDITOR_GRID_DATA_MODEL::ITEM_NUMBER_VARIABLE = wxS( "${ITEM_NUMBER}" );
@@ -307,6 +309,19 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::cmp( const DATA_MODEL_ROW&          lhGroup,
     else if( rhGroup.m_Refs.size() == 0 )
         return false;
 
+    wxString lhs = dataModel->GetValue( lhGroup, sortCol ).Trim( true ).Trim( false );
+    wxString rhs = dataModel->GetValue( rhGroup, sortCol ).Trim( true ).Trim( false );
+    wxString lhRef = lhGroup.m_Refs[0].GetRef() + lhGroup.m_Refs[0].GetRefNumber();
+    wxString rhRef = rhGroup.m_Refs[0].GetRef() + rhGroup.m_Refs[0].GetRefNumber();
+
+    return cmpKeys( lhs, lhRef, rhs, rhRef, sortCol, ascending );
+}
+
+
+bool FIELDS_EDITOR_GRID_DATA_MODEL::cmpKeys( const wxString& lhValue, const wxString& lhRef,
+                                             const wxString& rhValue, const wxString& rhRef,
+                                             int sortCol, bool ascending )
+{
     // N.B. To meet the iterator sort conditions, we cannot simply invert the truth
     // to get the opposite sort.  i.e. ~(a<b) != (a>b)
     auto local_cmp =
@@ -319,20 +334,10 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::cmp( const DATA_MODEL_ROW&          lhGroup,
             };
 
     // Primary sort key is sortCol; secondary is always REFERENCE (column 0)
-
-    wxString lhs = dataModel->GetValue( lhGroup, sortCol ).Trim( true ).Trim( false );
-    wxString rhs = dataModel->GetValue( rhGroup, sortCol ).Trim( true ).Trim( false );
-
-    if( lhs == rhs || sortCol == REFERENCE_FIELD )
-    {
-        wxString lhRef = lhGroup.m_Refs[0].GetRef() + lhGroup.m_Refs[0].GetRefNumber();
-        wxString rhRef = rhGroup.m_Refs[0].GetRef() + rhGroup.m_Refs[0].GetRefNumber();
+    if( lhValue == rhValue || sortCol == REFERENCE_FIELD )
         return local_cmp( StrNumCmp( lhRef, rhRef, true ), 0 );
-    }
     else
-    {
-        return local_cmp( ValueStringCompare( lhs, rhs ), 0 );
-    }
+        return local_cmp( ValueStringCompare( lhValue, rhValue ), 0 );
 }
 
 
@@ -353,12 +358,53 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::Sort()
                    } );
     }
 
-    std::sort( m_rows.begin(), m_rows.end(),
-               [this]( const DATA_MODEL_ROW& lhs, const DATA_MODEL_ROW& rhs ) -> bool
+    // Compute the sort keys once per row rather than for each comparison: the value of a group
+    // is the value shared by all its symbols, which is expensive to get on large groups.
+    struct SORT_KEY
+    {
+        wxString m_value;
+        wxString m_ref;
+        size_t   m_row;
+    };
+
+    std::vector<SORT_KEY> keys;
+    keys.reserve( m_rows.size() );
+
+    for( size_t i = 0; i < m_rows.size(); ++i )
+    {
+        const DATA_MODEL_ROW& row = m_rows[i];
+        SORT_KEY              key{ wxEmptyString, wxEmptyString, i };
+
+        if( !row.m_Refs.empty() )
+        {
+            key.m_value = GetValue( row, m_sortColumn ).Trim( true ).Trim( false );
+            key.m_ref = row.m_Refs[0].GetRef() + row.m_Refs[0].GetRefNumber();
+        }
+
+        keys.push_back( std::move( key ) );
+    }
+
+    std::sort( keys.begin(), keys.end(),
+               [this]( const SORT_KEY& lhs, const SORT_KEY& rhs ) -> bool
                {
-                   return cmp( lhs, rhs, this, m_sortColumn, m_sortAscending );
+                   // Empty rows always go to the bottom, whether ascending or descending
+                   if( m_rows[lhs.m_row].m_Refs.empty() )
+                       return true;
+                   else if( m_rows[rhs.m_row].m_Refs.empty() )
+                       return false;
+
+                   return cmpKeys( lhs.m_value, lhs.m_ref, rhs.m_value, rhs.m_ref, m_sortColumn,
+                                   m_sortAscending );
                } );
 
+    std::vector<DATA_MODEL_ROW> sortedRows;
+    sortedRows.reserve( m_rows.size() );
+
+    for( const SORT_KEY& key : keys )
+        sortedRows.push_back( std::move( m_rows[key.m_row] ) );
+
+    m_rows = std::move( sortedRows );
+
     // Time to renumber the item numbers
     int itemNumber = 1;
     for( DATA_MODEL_ROW& row : m_rows )
@@ -381,71 +427,57 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::unitMatch( const SCH_REFERENCE& lhRef,
 }
 
 
-bool FIELDS_EDITOR_GRID_DATA_MODEL::groupMatch( const SCH_REFERENCE& lhRef,
-                                                const SCH_REFERENCE& rhRef )
-
+bool FIELDS_EDITOR_GRID_DATA_MODEL::groupKey( const SCH_REFERENCE& aRef, int aRefCol,
+                                              wxString& aKey )
 {
-    int  refCol = GetFieldNameCol( GetCanonicalFieldName( REFERENCE_FIELD ) );
-    bool matchFound = false;
+    bool grouped = false;
 
-    if( refCol == -1 )
+    aKey.clear();
+
+    if( aRefCol == -1 )
         return false;
 
     // First check the reference column.  This can be done directly out of the
     // SCH_REFERENCEs as the references can't be edited in the grid.
-    if( m_cols[refCol].m_group )
+    if( m_cols[aRefCol].m_group )
     {
         // if we're grouping by reference, then only the prefix must match
-        if( lhRef.GetRef() != rhRef.GetRef() )
-            return false;
-
-        matchFound = true;
+        aKey << aRef.GetRef();
+        grouped = true;
     }
 
-    const KIID& lhRefID = lhRef.GetSymbol()->m_Uuid;
-    const KIID& rhRefID = rhRef.GetSymbol()->m_Uuid;
-
-    // Now check all the other columns.
+    // Now add all the other columns.
     for( size_t i = 0; i < m_cols.size(); ++i )
     {
         //Handled already
-        if( (int) i == refCol )
+        if( (int) i == aRefCol )
             continue;
 
         if( !m_cols[i].m_group )
             continue;
 
-        // If the field is a variable, we need to resolve it through the symbol
-        // to get the actual current value, otherwise we need to pull it out of the
-        // store so the refresh can regroup based on values that haven't been applied
-        // to the schematic yet.
-        wxString lh, rh;
-
-        if( IsTextVar( m_cols[i].m_fieldName )
-            || IsTextVar( m_dataStore[lhRefID][m_cols[i].m_fieldName] ) )
-        {
-            lh = getFieldShownText( lhRef, m_cols[i].m_fieldName );
-        }
-        else
-            lh = m_dataStore[lhRefID][m_cols[i].m_fieldName];
+        // Separate the values so "ab" + "c" doesn't match "a" + "bc"
+        aKey << wxS( "\x1F" ) << getGroupValue( aRef, m_cols[i].m_fieldName );
+        grouped = true;
+    }
 
-        if( IsTextVar( m_cols[i].m_fieldName )
-            || IsTextVar( m_dataStore[rhRefID][m_cols[i].m_fieldName] ) )
-        {
-            rh = getFieldShownText( rhRef, m_cols[i].m_fieldName );
-        }
-        else
-            rh = m_dataStore[rhRefID][m_cols[i].m_fieldName];
+    return grouped;
+}
 
-        wxString fieldName = m_cols[i].m_fieldName;
 
-        if( lh != rh )
-            return false;
+wxString FIELDS_EDITOR_GRID_DATA_MODEL::getGroupValue( const SCH_REFERENCE& aRef,
+                                                       const wxString&      aFieldName )
+{
+    const KIID& refID = aRef.GetSymbol()->m_Uuid;
 
-        matchFound = true;
-    }
+    // If the field is a variable, we need to resolve it through the symbol
+    // to get the actual current value, otherwise we need to pull it out of the
+    // store so the refresh can regroup based on values that haven't been applied
+    // to the schematic yet.
+    if( IsTextVar( aFieldName ) || IsTextVar( m_dataStore[refID][aFieldName] ) )
+        return getFieldShownText( aRef, aFieldName );
 
-    return matchFound;
+    return m_dataStore[refID][aFieldName];
 }
 
 
@@ -548,9 +580,17 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RebuildRows()
 
     m_rows.clear();
 
+    // The rows by the annotated reference and by the group key of their first symbol, so
+    // finding the row a symbol belongs to doesn't need to compare it with every row.
+    std::unordered_map<wxString, size_t> unitRows;
+    std::unordered_map<wxString, size_t> groupRows;
+    int                                  refCol = GetFieldNameCol(
+                                                      GetCanonicalFieldName( REFERENCE_FIELD ) );
+    wxString                             key;
+
     for( unsigned i = 0; i < m_symbolsList.GetCount(); ++i )
     {
-        SCH_REFERENCE ref = m_symbolsList[i];
+        const SCH_REFERENCE& ref = m_symbolsList[i];
 
         if( !m_filter.IsEmpty() && !WildCompareString( m_filter, ref.GetFullRef(), false ) )
             continue;
@@ -570,38 +610,56 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RebuildRows()
             continue;
         }
 
-        bool matchFound = false;
+        // If unannotated then we can't tell what units belong together
+        bool     annotated = ref.GetRefNumber() != wxT( "?" );
+        wxString unitKey = ref.GetRef() + wxS( "\x1F" ) + ref.GetRefNumber();
 
-        // Performance optimization for ungrouped case to skip the N^2 for loop
+        // Performance optimization for ungrouped case to skip the row lookups
         if( !m_groupingEnabled && !ref.IsMultiUnit() )
         {
+            if( annotated )
+                unitRows.emplace( unitKey, m_rows.size() );
+
             m_rows.emplace_back( DATA_MODEL_ROW( ref, GROUP_SINGLETON ) );
             continue;
         }
 
-        // See if we already have a row which this symbol fits into
-        for( DATA_MODEL_ROW& row : m_rows )
+        bool   grouped = m_groupingEnabled && groupKey( ref, refCol, key );
+        size_t unitRow = m_rows.size();
+        size_t groupRow = m_rows.size();
+
+        if( annotated )
         {
-            // all group members must have identical refs so just use the first one
-            SCH_REFERENCE rowRef = row.m_Refs[0];
+            if( auto it = unitRows.find( unitKey ); it != unitRows.end() )
+                unitRow = it->second;
+        }
 
-            if( unitMatch( ref, rowRef ) )
-            {
-                matchFound = true;
-                row.m_Refs.push_back( ref );
-                break;
-            }
-            else if( m_groupingEnabled && groupMatch( ref, rowRef ) )
-            {
-                matchFound = true;
-                row.m_Refs.push_back( ref );
-                row.m_Flag = GROUP_COLLAPSED;
-                break;
-            }
+        if( grouped )
+        {
+            if( auto it = groupRows.find( key ); it != groupRows.end() )
+                groupRow = it->second;
         }
 
-        if( !matchFound )
+        // The symbol goes to the first row it fits into, as another unit or as a group member
+        if( unitRow < m_rows.size() && unitRow <= groupRow )
+        {
+            m_rows[unitRow].m_Refs.push_back( ref );
+        }
+        else if( groupRow < m_rows.size() )
+        {
+            m_rows[groupRow].m_Refs.push_back( ref );
+            m_rows[groupRow].m_Flag = GROUP_COLLAPSED;
+        }
+        else
+        {
+            if( annotated )
+                unitRows.emplace( unitKey, m_rows.size() );
+
+            if( grouped )
+                groupRows.emplace( key, m_rows.size() );
+
             m_rows.emplace_back( DATA_MODEL_ROW( ref, GROUP_SINGLETON ) );
+        }
     }
 
     if( GetView() )
@@ -614,6 +672,19 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RebuildRows()
 }
 
 
+void FIELDS_EDITOR_GRID_DATA_MODEL::SortRows()
+{
+    if( !m_rebuildsEnabled )
+        return;
+
+    // Commit any pending in-place edits before the row gets moved out from under the editor.
+    if( GetView() )
+        static_cast<WX_GRID*>( GetView() )->CommitPendingChanges( true );
+
+    Sort();
+}
+
+
 void FIELDS_EDITOR_GRID_DATA_MODEL::ExpandRow( int aRow )
 {
     std::vector<DATA_MODEL_ROW> children;
@@ -957,7 +1028,7 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::AddReferences( const SCH_REFERENCE_LIST& aRe
 {
     for( const SCH_REFERENCE& ref : aRefs )
     {
-        if( !m_symbolsList.Contains( ref ) )
+        if( m_symbolPaths.insert( ref.GetFullPath() ).second )
         {
             m_symbolsList.AddItem( ref );
 
@@ -978,9 +1049,13 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RemoveSymbol( const SCH_SYMBOL& aSymbol )
 
     // Remove all refs that match this symbol using remove_if
     m_symbolsList.erase( std::remove_if( m_symbolsList.begin(), m_symbolsList.end(),
-                                         [&aSymbol]( const SCH_REFERENCE& ref ) -> bool
+                                         [&]( const SCH_REFERENCE& ref ) -> bool
                                          {
-                                             return ref.GetSymbol()->m_Uuid == aSymbol.m_Uuid;
+                                             if( ref.GetSymbol()->m_Uuid != aSymbol.m_Uuid )
+                                                 return false;
+
+                                             m_symbolPaths.erase( ref.GetFullPath() );
+                                             return true;
                                          } ),
                          m_symbolsList.end() );
 }
@@ -988,19 +1063,32 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RemoveSymbol( const SCH_SYMBOL& aSymbol )
 
 void FIELDS_EDITOR_GRID_DATA_MODEL::RemoveReferences( const SCH_REFERENCE_LIST& aRefs )
 {
+    std::unordered_set<wxString> removedPaths;
+
     for( const SCH_REFERENCE& ref : aRefs )
     {
-        int index = m_symbolsList.FindRefByFullPath( ref.GetFullPath() );
+        wxString path = ref.GetFullPath();
 
-        if( index != -1 )
+        if( m_symbolPaths.erase( path ) )
         {
-            m_symbolsList.RemoveItem( index );
+            removedPaths.insert( path );
 
             // If we're out of instances then remove the symbol, too
             if( ref.GetSymbol()->GetInstances().empty() )
                 m_dataStore.erase( ref.GetSymbol()->m_Uuid );
         }
     }
+
+    // Remove them all in one pass, which is a lot faster than one at a time on large designs
+    if( !removedPaths.empty() )
+    {
+        m_symbolsList.erase( std::remove_if( m_symbolsList.begin(), m_symbolsList.end(),
+                                             [&]( const SCH_REFERENCE& ref ) -> bool
+                                             {
+                                                 return removedPaths.count( ref.GetFullPath() );
+                                             } ),
+                             m_symbolsList.end() );
+    }
 }
 
 
@@ -1014,7 +1102,7 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::UpdateReferences( const SCH_REFERENCE_LIST&
         for( const DATA_MODEL_COL& col : m_cols )
             updateDataStoreSymbolField( *ref.GetSymbol(), col.m_fieldName );
 
-        if( !m_symbolsList.Contains( ref ) )
+        if( m_symbolPaths.insert( ref.GetFullPath() ).second )
             m_symbolsList.AddItem( ref );
     }
 }
@@ -20,6 +20,8 @@
 #include <sch_reference_list.h>
 #include <wx/grid.h>
 
+#include <unordered_set>
+
 // The field name in the data model (translated)
 #define DISPLAY_NAME_COLUMN   0
 
@@ -86,6 +88,9 @@ public:
             m_excludeDNP( false ), m_includeExcluded( false ), m_rebuildsEnabled( true )
     {
         m_symbolsList.SplitReferences();
+
+        for( const SCH_REFERENCE& ref : m_symbolsList )
+            m_symbolPaths.insert( ref.GetFullPath() );
     }
 
     static const wxString QUANTITY_VARIABLE;
@@ -185,6 +190,11 @@ public:
     void DisableRebuilds();
     void RebuildRows();
 
+    /**
+     * Sort the rows again (after a change of the sort column) without regrouping them.
+     */
+    void SortRows();
+
     void ExpandRow( int aRow );
     void CollapseRow( int aRow );
     void ExpandCollapseRow( int aRow );
@@ -256,8 +266,18 @@ public:
 private:
     static bool cmp( const DATA_MODEL_ROW& lhGroup, const DATA_MODEL_ROW& rhGroup,
                      FIELDS_EDITOR_GRID_DATA_MODEL* dataModel, int sortCol, bool ascending );
+    static bool cmpKeys( const wxString& lhValue, const wxString& lhRef, const wxString& rhValue,
+                         const wxString& rhRef, int sortCol, bool ascending );
     bool        unitMatch( const SCH_REFERENCE& lhRef, const SCH_REFERENCE& rhRef );
-    bool        groupMatch( const SCH_REFERENCE& lhRef, const SCH_REFERENCE& rhRef );
+
+    /**
+     * Build the key of the values \a aRef is grouped by: symbols with the same key belong
+     * to the same row.
+     *
+     * @return false if no column is grouped.
+     */
+    bool     groupKey( const SCH_REFERENCE& aRef, int aRefCol, wxString& aKey );
+    wxString getGroupValue( const SCH_REFERENCE& aRef, const wxString& aFieldName );
 
     // Helper functions to deal with translating wxGrid values to and from
     // named field values like ${DNP}
@@ -294,6 +314,9 @@ protected:
     std::vector<DATA_MODEL_COL> m_cols;
     std::vector<DATA_MODEL_ROW> m_rows;
 
+    /// Full paths of the references in m_symbolsList, to find them without a linear search
+    std::unordered_set<wxString> m_symbolPaths;
+
     // Data store
     // The data model is fundamentally m_componentRefs X m_fieldNames.
     // A map of compID : fieldSet, where fieldSet is a map of fieldName : fieldValue
@@ -39,6 +39,7 @@
 
 #include <symbol_lib_table.h>
 
+#include <memory>
 #include <set>
 
 static bool sortPinsByNumber( SCH_PIN* aPin1, SCH_PIN* aPin2 );
@@ -89,6 +90,57 @@ XNODE* NETLIST_EXPORTER_XML::makeRoot( unsigned aCtl )
 }
 
 
+void NETLIST_EXPORTER_XML::formatRoot( OUTPUTFORMATTER* aOut, unsigned aCtl )
+{
+    // Same output as makeRoot()->Format( aOut, 0 ), but only one section, symbol or net is held
+    // in memory at a time.  XNODE::Format() writes a newline between siblings and before the
+    // first child, which is the same as a newline before each child.
+    auto formatChild =
+            [&]( XNODE* aChild, int aNestLevel )
+            {
+                std::unique_ptr<XNODE> child( aChild );
+
+                aOut->Print( 0, "\n" );
+                child->Format( aOut, aNestLevel );
+            };
+
+    auto sink =
+            [&]( XNODE* aChild )
+            {
+                formatChild( aChild, 2 );
+            };
+
+    aOut->Print( 0, "(export (version %s)", aOut->Quotew( wxT( "E" ) ).c_str() );
+
+    if( aCtl & GNL_HEADER )
+        formatChild( makeDesignHeader(), 1 );
+
+    if( aCtl & GNL_SYMBOLS )
+    {
+        aOut->Print( 0, "\n" );
+        aOut->Print( 1, "(components" );
+        makeSymbols( aCtl, sink );
+        aOut->Print( 0, ")" );
+    }
+
+    if( aCtl & GNL_PARTS )
+        formatChild( makeLibParts(), 1 );
+
+    if( aCtl & GNL_LIBRARIES )
+        formatChild( makeLibraries(), 1 );
+
+    if( aCtl & GNL_NETS )
+    {
+        aOut->Print( 0, "\n" );
+        aOut->Print( 1, "(nets" );
+        makeListOfNets( aCtl, sink );
+        aOut->Print( 0, ")" );
+    }
+
+    aOut->Print( 0, ")" );
+}
+
+
 /// Holder for multi-unit symbol fields
 
 
@@ -243,6 +295,18 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
 {
     XNODE* xcomps = node( wxT( "components" ) );
 
+    makeSymbols( aCtl,
+                 [&]( XNODE* aComp )
+                 {
+                     xcomps->AddChild( aComp );
+                 } );
+
+    return xcomps;
+}
+
+
+void NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl, const NODE_SINK& aSink )
+{
     m_referencesAlreadyFound.Clear();
     m_libParts.clear();
 
@@ -307,8 +371,7 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
             // not always look best, but it will allow faster execution under XSL processing
             // systems which do sequential searching within an element.
 
-            XNODE* xcomp;  // current symbol being constructed
-            xcomps->AddChild( xcomp = node( wxT( "comp" ) ) );
+            XNODE* xcomp = node( wxT( "comp" ) );  // current symbol being constructed
 
             xcomp->AddAttribute( wxT( "ref" ), symbol->GetRef( &sheet ) );
             addSymbolFields( xcomp, symbol, sheet, sheetList );
@@ -436,12 +499,12 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
             // Output the primary UUID
             uuid = symbol->m_Uuid.AsString();
             xunits->AddChild( new XNODE( wxXML_TEXT_NODE, wxEmptyString, uuid ) );
+
+            aSink( xcomp );
         }
     }
 
     m_schematic->SetCurrentSheet( currentSheet );
-
-    return xcomps;
 }
 
 
@@ -667,7 +730,20 @@ XNODE* NETLIST_EXPORTER_XML::makeLibParts()
 
 XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
 {
-    XNODE*      xnets = node( wxT( "nets" ) );      // auto_ptr if exceptions ever get used.
+    XNODE* xnets = node( wxT( "nets" ) );      // auto_ptr if exceptions ever get used.
+
+    makeListOfNets( aCtl,
+                    [&]( XNODE* aNet )
+                    {
+                        xnets->AddChild( aNet );
+                    } );
+
+    return xnets;
+}
+
+
+void NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl, const NODE_SINK& aSink )
+{
     wxString    netCodeTxt;
     wxString    netName;
     wxString    ref;
@@ -817,7 +893,7 @@ XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
             {
                 netCodeTxt.Printf( wxT( "%d" ), i + 1 );
 
-                xnets->AddChild( xnet = node( wxT( "net" ) ) );
+                xnet = node( wxT( "net" ) );
                 xnet->AddAttribute( wxT( "code" ), netCodeTxt );
                 xnet->AddAttribute( wxT( "name" ), net_record->m_Name );
 
@@ -840,12 +916,13 @@ XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
 
             xnode->AddAttribute( wxT( "pintype" ), pinType );
         }
+
+        if( added )
+            aSink( xnet );
     }
 
     for( NET_RECORD* record : nets )
         delete record;
-
-    return xnets;
 }
 
 
@@ -32,7 +32,10 @@
 
 #include <sch_edit_frame.h>
 
+#include <functional>
+
 class CONNECTION_GRAPH;
+class OUTPUTFORMATTER;
 class SYMBOL_LIB_TABLE;
 class XNODE;
 
@@ -100,11 +103,28 @@ protected:
      */
     XNODE* makeRoot( unsigned aCtl = GNL_ALL );
 
+    /**
+     * Write the same S-expression document as makeRoot()->Format( aOut, 0 ) without building
+     * the whole tree: the symbols and nets are formatted and freed one at a time, so memory use
+     * doesn't grow with the size of the design.
+     */
+    void formatRoot( OUTPUTFORMATTER* aOut, unsigned aCtl = GNL_ALL );
+
+    /**
+     * Receives the "comp" or "net" nodes as they are built, and takes ownership of them.
+     */
+    typedef std::function<void( XNODE* aNode )> NODE_SINK;
+
     /**
      * @return a sub-tree holding all the schematic symbols.
      */
     XNODE* makeSymbols( unsigned aCtl );
 
+    /**
+     * Build the "comp" node of each schematic symbol in turn and hand it to \a aSink.
+     */
+    void makeSymbols( unsigned aCtl, const NODE_SINK& aSink );
+
     /**
      * Fill out a project "design" header into an XML node.
      * @return the design header
@@ -123,6 +143,11 @@ protected:
      */
     XNODE* makeListOfNets( unsigned aCtl );
 
+    /**
+     * Build the "net" node of each net in turn and hand it to \a aSink.
+     */
+    void makeListOfNets( unsigned aCtl, const NODE_SINK& aSink );
+
     /**
      * Fill out an XML node with a list of used libraries and returns it.
      * Must have called makeGenericLibParts() before this function.
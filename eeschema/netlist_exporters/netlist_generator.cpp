@@ -68,6 +68,8 @@ bool SCH_EDIT_FRAME::WriteNetListFile( int aFormat, const wxString& aFullFileNam
 
     SCHEMATIC* sch = &Schematic();
 
+    SHOWN_TEXT_CACHE_ENABLER shownTextCache( sch );
+
     switch( aFormat )
     {
     case NET_TYPE_PCBNEW:
@@ -356,6 +356,8 @@ void SCH_COMMIT::pushSchEdit( const wxString& aMessage, int aCommitFlags )
 
     if( schematic )
     {
+        schematic->InvalidateShownTextCache();
+
         if( bulkAddedItems.size() > 0 )
             schematic->OnItemsAdded( bulkAddedItems );
 
@@ -610,6 +612,8 @@ void SCH_COMMIT::Revert()
 
     if( schematic )
     {
+        schematic->InvalidateShownTextCache();
+
         if( bulkAddedItems.size() > 0 )
             schematic->OnItemsAdded( bulkAddedItems );
 
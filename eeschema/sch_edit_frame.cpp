@@ -1969,6 +1969,8 @@ void SCH_EDIT_FRAME::RecalculateConnections( SCH_COMMIT* aCommit, SCH_CLEANUP_FL
             }
         }
 
+        PROF_TIMER incrementalTimer;
+
         std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> all_items =
                 Schematic().ConnectionGraph()->ExtractAffectedItems( changed_items );
 
@@ -2000,6 +2002,10 @@ void SCH_EDIT_FRAME::RecalculateConnections( SCH_COMMIT* aCommit, SCH_CLEANUP_FL
 
         new_graph.Recalculate( list, false, &changeHandler );
         Schematic().ConnectionGraph()->Merge( new_graph );
+
+        wxLogTrace( ConnProfileMask, "Incremental connectivity: %zu changed items, %zu "
+                                     "affected items, %0.4f ms",
+                    changed_items.size(), all_items.size(), incrementalTimer.msecs() );
     }
 
     GetCanvas()->GetView()->UpdateAllItemsConditionally(
@@ -2083,6 +2089,9 @@ void SCH_EDIT_FRAME::CommonSettingsChanged( bool aEnvVarsChanged, bool aTextVars
 {
     SCH_BASE_FRAME::CommonSettingsChanged( aEnvVarsChanged, aTextVarsChanged );
 
+    if( aTextVarsChanged )
+        Schematic().InvalidateShownTextCache();
+
     SCHEMATIC_SETTINGS& settings = Schematic().Settings();
 
     settings.m_JunctionSize = GetSchematicJunctionSize();
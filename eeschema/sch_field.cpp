@@ -258,7 +258,14 @@ wxString SCH_FIELD::GetShownText( const SCH_SHEET_PATH* aPath, bool aAllowExtraT
                 return label->ResolveTextVar( aPath, token, aDepth + 1 );
             };
 
-    wxString text = EDA_TEXT::GetShownText( aAllowExtraText, aDepth );
+    // Only top-level expansions are cached; nested ones depend on the caller's context
+    SCHEMATIC* schematic = ( aDepth == 0 && HasTextVars() ) ? Schematic() : nullptr;
+    wxString   text;
+
+    if( schematic && schematic->GetCachedShownText( this, aPath, aAllowExtraText, &text ) )
+        return text;
+
+    text = EDA_TEXT::GetShownText( aAllowExtraText, aDepth );
 
     if( IsNameShown() && aAllowExtraText )
         text = GetShownName() << wxS( ": " ) << text;
@@ -312,6 +319,9 @@ wxString SCH_FIELD::GetShownText( const SCH_SHEET_PATH* aPath, bool aAllowExtraT
             text = _( "File:" ) + wxS( " " ) + text;
     }
 
+    if( schematic )
+        schematic->CacheShownText( this, aPath, aAllowExtraText, text );
+
     return text;
 }
 
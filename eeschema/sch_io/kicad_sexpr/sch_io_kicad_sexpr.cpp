@@ -82,7 +82,6 @@ SCH_IO_KICAD_SEXPR::SCH_IO_KICAD_SEXPR() : SCH_IO( wxS( "Eeschema s-expression"
 
 SCH_IO_KICAD_SEXPR::~SCH_IO_KICAD_SEXPR()
 {
-    delete m_cache;
 }
 
 
@@ -1610,16 +1609,24 @@ void SCH_IO_KICAD_SEXPR::cacheLib( const wxString& aLibraryFileName,
 
     if( !m_cache || !m_cache->IsFile( aLibraryFileName ) || m_cache->IsFileChanged() )
     {
-        // a spectacular episode in memory management:
-        delete m_cache;
-        m_cache = new SCH_IO_KICAD_SEXPR_LIB_CACHE( aLibraryFileName );
+        m_cache = std::make_unique<SCH_IO_KICAD_SEXPR_LIB_CACHE>( aLibraryFileName );
 
+        // The file contents are shared with the other plugins (and so the other library
+        // tables and frames) reading the library; the symbols are parsed when needed.
         if( !isBuffering( aProperties ) )
-            m_cache->Load();
+            m_cache->LoadLazily();
     }
 }
 
 
+void SCH_IO_KICAD_SEXPR::privateCacheLib( const wxString& aLibraryFileName,
+                                          const STRING_UTF8_MAP* aProperties )
+{
+    cacheLib( aLibraryFileName, aProperties );
+    m_cache->ParseAllSymbols();
+}
+
+
 bool SCH_IO_KICAD_SEXPR::isBuffering( const STRING_UTF8_MAP* aProperties )
 {
     return ( aProperties && aProperties->Exists( SCH_IO_KICAD_SEXPR::PropBuffering ) );
@@ -1647,13 +1654,7 @@ void SCH_IO_KICAD_SEXPR::EnumerateSymbolLib( wxArrayString&    aSymbolNameList,
 
     cacheLib( aLibraryPath, aProperties );
 
-    const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
-
-    for( LIB_SYMBOL_MAP::const_iterator it = symbols.begin();  it != symbols.end();  ++it )
-    {
-        if( !powerSymbolsOnly || it->second->IsPower() )
-            aSymbolNameList.Add( it->first );
-    }
+    m_cache->GetSymbolNames( aSymbolNameList, powerSymbolsOnly );
 }
 
 
@@ -1668,13 +1669,7 @@ void SCH_IO_KICAD_SEXPR::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolLi
 
     cacheLib( aLibraryPath, aProperties );
 
-    const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
-
-    for( LIB_SYMBOL_MAP::const_iterator it = symbols.begin();  it != symbols.end();  ++it )
-    {
-        if( !powerSymbolsOnly || it->second->IsPower() )
-            aSymbolList.push_back( it->second );
-    }
+    m_cache->GetSymbols( aSymbolList, powerSymbolsOnly );
 }
 
 
@@ -1686,23 +1681,20 @@ LIB_SYMBOL* SCH_IO_KICAD_SEXPR::LoadSymbol( const wxString& aLibraryPath,
 
     cacheLib( aLibraryPath, aProperties );
 
-    LIB_SYMBOL_MAP::const_iterator it = m_cache->m_symbols.find( aSymbolName );
+    LIB_SYMBOL* symbol = m_cache->FindSymbol( aSymbolName );
 
     // We no longer escape '/' in symbol names, but we used to.
-    if( it == m_cache->m_symbols.end() && aSymbolName.Contains( '/' ) )
-        it = m_cache->m_symbols.find( EscapeString( aSymbolName, CTX_LEGACY_LIBID ) );
+    if( !symbol && aSymbolName.Contains( '/' ) )
+        symbol = m_cache->FindSymbol( EscapeString( aSymbolName, CTX_LEGACY_LIBID ) );
 
-    if( it == m_cache->m_symbols.end() && aSymbolName.Contains( wxT( "{slash}" ) ) )
+    if( !symbol && aSymbolName.Contains( wxT( "{slash}" ) ) )
     {
         wxString unescaped = aSymbolName;
         unescaped.Replace( wxT( "{slash}" ), wxT( "/" ) );
-        it = m_cache->m_symbols.find( unescaped );
+        symbol = m_cache->FindSymbol( unescaped );
     }
 
-    if( it == m_cache->m_symbols.end() )
-        return nullptr;
-
-    return it->second;
+    return symbol;
 }
 
 
@@ -1711,7 +1703,7 @@ void SCH_IO_KICAD_SEXPR::SaveSymbol( const wxString& aLibraryPath, const LIB_SYM
 {
     LOCALE_IO toggle;     // toggles on, then off, the C locale.
 
-    cacheLib( aLibraryPath, aProperties );
+    privateCacheLib( aLibraryPath, aProperties );
 
     m_cache->AddSymbol( aSymbol );
 
@@ -1725,7 +1717,7 @@ void SCH_IO_KICAD_SEXPR::DeleteSymbol( const wxString& aLibraryPath, const wxStr
 {
     LOCALE_IO toggle;     // toggles on, then off, the C locale.
 
-    cacheLib( aLibraryPath, aProperties );
+    privateCacheLib( aLibraryPath, aProperties );
 
     m_cache->DeleteSymbol( aSymbolName );
 
@@ -1745,8 +1737,7 @@ void SCH_IO_KICAD_SEXPR::CreateLibrary( const wxString& aLibraryPath,
 
     LOCALE_IO toggle;
 
-    delete m_cache;
-    m_cache = new SCH_IO_KICAD_SEXPR_LIB_CACHE( aLibraryPath );
+    m_cache = std::make_unique<SCH_IO_KICAD_SEXPR_LIB_CACHE>( aLibraryPath );
     m_cache->SetModified();
     m_cache->Save();
     m_cache->Load();    // update m_writable and m_mod_time
@@ -1770,10 +1761,7 @@ bool SCH_IO_KICAD_SEXPR::DeleteLibrary( const wxString& aLibraryPath,
     }
 
     if( m_cache && m_cache->IsFile( aLibraryPath ) )
-    {
-        delete m_cache;
         m_cache = nullptr;
-    }
 
     return true;
 }
@@ -1783,7 +1771,9 @@ void SCH_IO_KICAD_SEXPR::SaveLibrary( const wxString& aLibraryPath,
                                       const STRING_UTF8_MAP* aProperties )
 {
     if( !m_cache )
-        m_cache = new SCH_IO_KICAD_SEXPR_LIB_CACHE( aLibraryPath );
+        m_cache = std::make_unique<SCH_IO_KICAD_SEXPR_LIB_CACHE>( aLibraryPath );
+
+    m_cache->ParseAllSymbols();
 
     wxString oldFileName = m_cache->GetFileName();
 
@@ -1812,14 +1802,14 @@ void SCH_IO_KICAD_SEXPR::GetAvailableSymbolFields( std::vector<wxString>& aNames
     if( !m_cache )
         return;
 
-    const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
-
+    // Only the symbols which were loaded, so listing the power symbols doesn't parse the rest
+    // of the library.
     std::set<wxString> fieldNames;
 
-    for( LIB_SYMBOL_MAP::const_iterator it = symbols.begin();  it != symbols.end();  ++it )
+    for( LIB_SYMBOL* symbol : m_cache->GetParsedSymbols() )
     {
         std::vector<SCH_FIELD*> fields;
-        it->second->GetFields( fields );
+        symbol->GetFields( fields );
 
         for( SCH_FIELD* field : fields )
         {
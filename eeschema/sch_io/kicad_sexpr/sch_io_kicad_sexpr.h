@@ -161,6 +161,9 @@ private:
     void saveInstances( const std::vector<SCH_SHEET_INSTANCE>& aSheets, int aNestLevel );
 
     void cacheLib( const wxString& aLibraryFileName, const STRING_UTF8_MAP* aProperties );
+
+    /// Like cacheLib(), but parses the whole library so it can be modified and saved.
+    void privateCacheLib( const wxString& aLibraryFileName, const STRING_UTF8_MAP* aProperties );
     bool isBuffering( const STRING_UTF8_MAP* aProperties );
 
 protected:
@@ -176,7 +179,7 @@ protected:
     SCH_SHEET_PATH          m_currentSheetPath;
     SCHEMATIC*              m_schematic;
     OUTPUTFORMATTER*        m_out;              ///< The formatter for saving SCH_SCREEN objects.
-    SCH_IO_KICAD_SEXPR_LIB_CACHE* m_cache;
+    std::unique_ptr<SCH_IO_KICAD_SEXPR_LIB_CACHE> m_cache;
 
     /// initialize PLUGIN like a constructor would.
     void init( SCHEMATIC* aSchematic, const STRING_UTF8_MAP* aProperties = nullptr );
@@ -19,6 +19,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <wx/ffile.h>
 #include <wx/log.h>
 #include <base_units.h>
 #include <build_version.h>
@@ -34,6 +35,9 @@
 #include <string_utils.h>
 #include <trace_helpers.h>
 
+#include <algorithm>
+#include <cctype>
+
 
 SCH_IO_KICAD_SEXPR_LIB_CACHE::SCH_IO_KICAD_SEXPR_LIB_CACHE( const wxString& aFullPathAndFileName ) :
     SCH_IO_LIB_CACHE( aFullPathAndFileName )
@@ -80,6 +84,423 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Load()
 }
 
 
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::LoadLazily()
+{
+    // Let Load() report any problem with the file.
+    if( !m_libFileName.FileExists() || !m_libFileName.IsAbsolute() )
+    {
+        Load();
+        return;
+    }
+
+    std::shared_ptr<const LIB_INDEX> index = getSharedIndex();
+
+    if( !index )
+    {
+        wxLogTrace( traceSchLegacyPlugin, "Cannot index '%s', parsing it all",
+                    m_libFileName.GetFullPath() );
+
+        Load();
+        return;
+    }
+
+    m_index = index;
+    m_unparsed = index->m_symbols;
+    IncrementModifyHash();
+
+    // Remember the file modification time of library file when the cache snapshot was made,
+    // so that in a networked environment we will reload the cache as needed.
+    m_fileModTime = index->m_fileModTime;
+    SetFileFormatVersionAtLoad( index->m_version );
+}
+
+
+std::shared_ptr<const SCH_IO_KICAD_SEXPR_LIB_CACHE::LIB_INDEX>
+SCH_IO_KICAD_SEXPR_LIB_CACHE::getSharedIndex()
+{
+    static std::mutex                                          s_mutex;
+    static std::map<wxString, std::weak_ptr<const LIB_INDEX>> s_indexes;
+
+    wxString   fullPath = m_libFileName.GetFullPath();
+    wxDateTime modTime = GetLibModificationTime();
+
+    {
+        std::lock_guard<std::mutex> lock( s_mutex );
+
+        auto it = s_indexes.find( fullPath );
+
+        if( it != s_indexes.end() )
+        {
+            std::shared_ptr<const LIB_INDEX> existing = it->second.lock();
+
+            if( existing && existing->m_fileModTime == modTime )
+                return existing;
+        }
+    }
+
+    // Read and index outside of the lock so different libraries load in parallel.  If two
+    // threads index the same library at once, the last one stored is kept.
+    wxFFile file;
+
+    if( !file.Open( fullPath, wxT( "rb" ) ) )
+        return nullptr;
+
+    wxLogTrace( traceSchLegacyPlugin, "Indexing sexpr symbol library file '%s'", fullPath );
+
+    std::shared_ptr<LIB_INDEX> index = std::make_shared<LIB_INDEX>();
+
+    index->m_text.resize( file.Length() );
+    index->m_text.resize( file.Read( index->m_text.data(), index->m_text.size() ) );
+    index->m_fileModTime = modTime;
+    file.Close();
+
+    if( !indexSymbols( *index ) )
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock( s_mutex );
+
+    s_indexes[fullPath] = index;
+
+    std::erase_if( s_indexes,
+                   []( const auto& aEntry )
+                   {
+                       return aEntry.second.expired();
+                   } );
+
+    return index;
+}
+
+
+bool SCH_IO_KICAD_SEXPR_LIB_CACHE::indexSymbols( LIB_INDEX& aIndex )
+{
+    const std::string& text = aIndex.m_text;
+    int&               version = aIndex.m_version;
+
+    // A quick scan of the top level lists of the file.  It only needs to find the extent,
+    // name, parent and power flag of the symbols; the parser still checks everything else
+    // once a symbol is needed.
+    size_t pos = 0;
+    int    line = 1;
+
+    auto skipSpace =
+            [&]()
+            {
+                while( pos < text.size() && isspace( (unsigned char) text[pos] ) )
+                {
+                    if( text[pos++] == '\n' )
+                        line++;
+                }
+            };
+
+    auto readAtom =
+            [&]() -> std::string
+            {
+                size_t start = pos;
+
+                while( pos < text.size() && !isspace( (unsigned char) text[pos] )
+                        && text[pos] != '(' && text[pos] != ')' && text[pos] != '"' )
+                {
+                    pos++;
+                }
+
+                return text.substr( start, pos - start );
+            };
+
+    // Escaped names are left to the parser.
+    auto readName =
+            [&]( wxString& aName ) -> bool
+            {
+                if( pos >= text.size() || text[pos] != '"' )
+                    return false;
+
+                size_t start = ++pos;
+
+                while( pos < text.size() && text[pos] != '"' )
+                {
+                    if( text[pos] == '\\' || text[pos] == '\n' )
+                        return false;
+
+                    pos++;
+                }
+
+                if( pos >= text.size() )
+                    return false;
+
+                aName = wxString::FromUTF8( text.substr( start, pos - start ) );
+                aName.Replace( wxS( "{slash}" ), wxT( "/" ) );
+                pos++;
+                return true;
+            };
+
+    // Skip past the end of the list whose head was just read.
+    auto skipList =
+            [&]() -> bool
+            {
+                int depth = 1;
+
+                while( pos < text.size() )
+                {
+                    char c = text[pos++];
+
+                    if( c == '\n' )
+                    {
+                        line++;
+                    }
+                    else if( c == '"' )
+                    {
+                        while( pos < text.size() && text[pos] != '"' )
+                        {
+                            if( text[pos] == '\\' )
+                                pos++;
+                            else if( text[pos] == '\n' )
+                                line++;
+
+                            pos++;
+                        }
+
+                        pos++;
+                    }
+                    else if( c == '(' )
+                    {
+                        depth++;
+                    }
+                    else if( c == ')' && --depth == 0 )
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            };
+
+    skipSpace();
+
+    if( pos >= text.size() || text[pos++] != '(' || readAtom() != "kicad_symbol_lib" )
+        return false;
+
+    while( true )
+    {
+        skipSpace();
+
+        if( pos >= text.size() || ( text[pos] != '(' && text[pos] != ')' ) )
+            return false;
+
+        if( text[pos] == ')' )
+            break;
+
+        UNPARSED_SYMBOL symbol{ pos, 0, line, wxEmptyString, false };
+
+        pos++;
+
+        std::string head = readAtom();
+
+        if( head == "version" )
+        {
+            skipSpace();
+            version = atoi( readAtom().c_str() );
+
+            if( !skipList() )
+                return false;
+        }
+        else if( head == "generator" || head == "generator_version" || head == "host" )
+        {
+            if( !skipList() )
+                return false;
+        }
+        else if( head == "symbol" )
+        {
+            wxString name;
+            LIB_ID   id;
+
+            skipSpace();
+
+            if( !readName( name ) || id.Parse( name ) >= 0 )
+                return false;
+
+            while( true )
+            {
+                skipSpace();
+
+                if( pos >= text.size() || text[pos] != '(' )
+                    break;
+
+                pos++;
+
+                std::string child = readAtom();
+
+                if( child == "extends" )
+                {
+                    skipSpace();
+
+                    if( !readName( symbol.m_parent ) )
+                        return false;
+                }
+                else if( child == "power" )
+                {
+                    symbol.m_power = true;
+                }
+
+                if( !skipList() )
+                    return false;
+            }
+
+            if( pos >= text.size() || text[pos++] != ')' )
+                return false;
+
+            symbol.m_length = pos - symbol.m_offset;
+            name = id.GetLibItemName().wx_str();
+
+            // Duplicates and parents defined after their children are errors or oddities
+            // best handled by the parser.
+            if( aIndex.m_symbols.count( name ) )
+                return false;
+
+            if( !symbol.m_parent.IsEmpty() )
+            {
+                auto parent = aIndex.m_symbols.find( symbol.m_parent );
+
+                if( parent == aIndex.m_symbols.end() )
+                    return false;
+
+                // A derived symbol is a power symbol if its root symbol is one.
+                symbol.m_power = parent->second.m_power;
+            }
+
+            aIndex.m_symbols[name] = symbol;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    // Leave version checks to the parser.
+    return version > 0 && version <= SEXPR_SYMBOL_LIB_FILE_VERSION;
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::parseSymbol( const wxString& aName )
+{
+    auto it = m_unparsed.find( aName );
+
+    if( it == m_unparsed.end() )
+        return;
+
+    UNPARSED_SYMBOL unparsed = it->second;
+
+    if( !unparsed.m_parent.IsEmpty() )
+        parseSymbol( unparsed.m_parent );
+
+    LOCALE_IO          toggle;
+    STRING_LINE_READER reader( m_index->m_text.substr( unparsed.m_offset, unparsed.m_length ),
+                               m_libFileName.GetFullPath() );
+
+    SCH_IO_KICAD_SEXPR_PARSER parser( &reader );
+    LIB_SYMBOL*               symbol = nullptr;
+
+    try
+    {
+        symbol = parser.ParseLibSymbol( m_symbols, GetFileFormatVersionAtLoad() );
+    }
+    catch( PARSE_ERROR& e )
+    {
+        // Report the line in the library file rather than in the symbol.
+        THROW_PARSE_ERROR( e.ParseProblem(), m_libFileName.GetFullPath(), e.inputLine.c_str(),
+                           e.lineNumber + unparsed.m_line - 1, e.byteIndex );
+    }
+
+    m_symbols[symbol->GetName()] = symbol;
+    m_unparsed.erase( aName );
+
+    // Let the file contents go once this cache doesn't need them anymore.
+    if( m_unparsed.empty() )
+        m_index.reset();
+}
+
+
+LIB_SYMBOL* SCH_IO_KICAD_SEXPR_LIB_CACHE::FindSymbol( const wxString& aName )
+{
+    std::lock_guard<std::mutex> lock( m_lazyMutex );
+
+    parseSymbol( aName );
+
+    LIB_SYMBOL_MAP::const_iterator it = m_symbols.find( aName );
+
+    return it != m_symbols.end() ? it->second : nullptr;
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::GetSymbolNames( wxArrayString& aNames, bool aPowerSymbolsOnly )
+{
+    std::lock_guard<std::mutex> lock( m_lazyMutex );
+
+    std::vector<wxString> names;
+
+    for( const auto& [ name, symbol ] : m_symbols )
+    {
+        if( !aPowerSymbolsOnly || symbol->IsPower() )
+            names.push_back( name );
+    }
+
+    for( const auto& [ name, unparsed ] : m_unparsed )
+    {
+        if( !aPowerSymbolsOnly || unparsed.m_power )
+            names.push_back( name );
+    }
+
+    std::sort( names.begin(), names.end(), LibSymbolMapSort() );
+
+    for( const wxString& name : names )
+        aNames.Add( name );
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::GetSymbols( std::vector<LIB_SYMBOL*>& aSymbols,
+                                               bool aPowerSymbolsOnly )
+{
+    std::lock_guard<std::mutex> lock( m_lazyMutex );
+
+    std::vector<wxString> toParse;
+
+    for( const auto& [ name, unparsed ] : m_unparsed )
+    {
+        if( !aPowerSymbolsOnly || unparsed.m_power )
+            toParse.push_back( name );
+    }
+
+    for( const wxString& name : toParse )
+        parseSymbol( name );
+
+    for( const auto& [ name, symbol ] : m_symbols )
+    {
+        if( !aPowerSymbolsOnly || symbol->IsPower() )
+            aSymbols.push_back( symbol );
+    }
+}
+
+
+std::vector<LIB_SYMBOL*> SCH_IO_KICAD_SEXPR_LIB_CACHE::GetParsedSymbols()
+{
+    std::lock_guard<std::mutex> lock( m_lazyMutex );
+
+    std::vector<LIB_SYMBOL*> symbols;
+
+    for( const auto& [ name, symbol ] : m_symbols )
+        symbols.push_back( symbol );
+
+    return symbols;
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::ParseAllSymbols()
+{
+    std::lock_guard<std::mutex> lock( m_lazyMutex );
+
+    while( !m_unparsed.empty() )
+        parseSymbol( m_unparsed.begin()->first );
+}
+
+
 void SCH_IO_KICAD_SEXPR_LIB_CACHE::Save( const std::optional<bool>& aOpt )
 {
     if( !m_isModified )
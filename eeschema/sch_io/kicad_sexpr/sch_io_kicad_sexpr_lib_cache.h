@@ -22,6 +22,12 @@
 #ifndef SCH_IO_KICAD_SEXPR_LIB_CACHE_H_
 #define SCH_IO_KICAD_SEXPR_LIB_CACHE_H_
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "sch_io/sch_io_lib_cache.h"
 
 class FILE_LINE_READER;
@@ -49,6 +55,47 @@ public:
 
     void Load() override;
 
+    /**
+     * Load the library like Load(), but only find where each symbol is in the file.  Symbols
+     * are parsed when they are first asked for, through FindSymbol(), GetSymbols() or
+     * ParseAllSymbols().
+     *
+     * The file contents and where the symbols are in it are shared with the other caches
+     * loading the same file lazily, but each cache parses and owns its own symbols.  Falls
+     * back to Load() for anything the quick scan doesn't understand.
+     */
+    void LoadLazily();
+
+    /**
+     * Return the symbol \a aName, parsing it (and its parents) first if needed.
+     *
+     * @return the symbol or nullptr if the library has no such symbol.
+     */
+    LIB_SYMBOL* FindSymbol( const wxString& aName );
+
+    /**
+     * Fill \a aNames with the symbol names of the library, in the #LIB_SYMBOL_MAP order.
+     * No symbol is parsed for this.
+     */
+    void GetSymbolNames( wxArrayString& aNames, bool aPowerSymbolsOnly );
+
+    /**
+     * Fill \a aSymbols with the symbols of the library, in the #LIB_SYMBOL_MAP order.  When
+     * \a aPowerSymbolsOnly is true, only the power symbols are parsed.
+     */
+    void GetSymbols( std::vector<LIB_SYMBOL*>& aSymbols, bool aPowerSymbolsOnly );
+
+    /**
+     * @return the symbols parsed so far, which is all of them if the library wasn't loaded
+     *         lazily.
+     */
+    std::vector<LIB_SYMBOL*> GetParsedSymbols();
+
+    /**
+     * Parse all the symbols not parsed yet, so m_symbols holds the whole library.
+     */
+    void ParseAllSymbols();
+
     void DeleteSymbol( const wxString& aName ) override;
 
     static void SaveSymbol( LIB_SYMBOL* aSymbol, OUTPUTFORMATTER& aFormatter, int aNestLevel = 0,
@@ -60,8 +107,50 @@ public:
 private:
     friend SCH_IO_KICAD_SEXPR;
 
+    /// Where an unparsed symbol is in the library file.
+    struct UNPARSED_SYMBOL
+    {
+        size_t   m_offset;
+        size_t   m_length;
+        int      m_line;            ///< Line number of the symbol in the file, for errors.
+        wxString m_parent;          ///< Name of the parent of a derived symbol.
+        bool     m_power;           ///< What LIB_SYMBOL::IsPower() will return.
+    };
+
+    /// The contents of a library file and where its symbols are.  Never modified once built,
+    /// so it can be shared between caches without locking.
+    struct LIB_INDEX
+    {
+        std::string                                            m_text;
+        std::map<wxString, UNPARSED_SYMBOL, LibSymbolMapSort>  m_symbols;
+        int                                                    m_version = 0;
+        wxDateTime                                             m_fileModTime;
+    };
+
+    /**
+     * Return the index of \a aLibraryPath shared by all the caches loading it lazily, building
+     * it if no cache holds it yet or if the file changed on disk.
+     *
+     * @return nullptr if the file isn't what the scan expects; the parser will tell what's wrong.
+     */
+    std::shared_ptr<const LIB_INDEX> getSharedIndex();
+
+    /**
+     * Fill \a aIndex from the library file contents \a aIndex.m_text.
+     *
+     * @return false if the file isn't what the scan expects.
+     */
+    static bool indexSymbols( LIB_INDEX& aIndex );
+
+    /// Parse the unparsed symbol \a aName, if any.  #m_lazyMutex must be locked.
+    void parseSymbol( const wxString& aName );
+
     int m_fileFormatVersionAtLoad;
 
+    std::mutex                                                 m_lazyMutex;
+    std::shared_ptr<const LIB_INDEX>                           m_index;
+    std::map<wxString, UNPARSED_SYMBOL, LibSymbolMapSort>      m_unparsed;
+
     static void saveSymbolDrawItem( SCH_ITEM* aItem, OUTPUTFORMATTER& aFormatter,
                                     int aNestLevel );
     static void saveField( SCH_FIELD* aField, OUTPUTFORMATTER& aFormatter, int aNestLevel );
@@ -288,6 +288,22 @@ LIB_SYMBOL* SCH_IO_KICAD_SEXPR_PARSER::ParseSymbol( LIB_SYMBOL_MAP& aSymbolLibMa
 }
 
 
+LIB_SYMBOL* SCH_IO_KICAD_SEXPR_PARSER::ParseLibSymbol( LIB_SYMBOL_MAP& aSymbolLibMap,
+                                                       int aFileVersion )
+{
+    NeedLEFT();
+
+    if( NextTok() != T_symbol )
+        Expecting( T_symbol );
+
+    m_requiredVersion = aFileVersion;
+    m_unit = 1;
+    m_bodyStyle = 1;
+
+    return parseLibSymbol( aSymbolLibMap );
+}
+
+
 LIB_SYMBOL* SCH_IO_KICAD_SEXPR_PARSER::parseLibSymbol( LIB_SYMBOL_MAP& aSymbolLibMap )
 {
     wxCHECK_MSG( CurTok() == T_symbol, nullptr,
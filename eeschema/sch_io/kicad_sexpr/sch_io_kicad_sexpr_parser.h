@@ -88,6 +88,13 @@ public:
     LIB_SYMBOL* ParseSymbol( LIB_SYMBOL_MAP& aSymbolLibMap,
                              int aFileVersion = SEXPR_SYMBOL_LIB_FILE_VERSION );
 
+    /**
+     * Parse a single "symbol" list of a symbol library file, the same way as ParseLib() does.
+     *
+     * The parent of a derived symbol must already be in \a aSymbolLibMap.
+     */
+    LIB_SYMBOL* ParseLibSymbol( LIB_SYMBOL_MAP& aSymbolLibMap, int aFileVersion );
+
     SCH_ITEM* ParseSymbolDrawItem();
 
     /**
@@ -873,7 +873,14 @@ wxString SCH_LABEL_BASE::GetShownText( const SCH_SHEET_PATH* aPath, bool aAllowE
                 return ResolveTextVar( aPath, token, aDepth + 1 );
             };
 
-    wxString text = EDA_TEXT::GetShownText( aAllowExtraText, aDepth );
+    // Only top-level expansions are cached; nested ones depend on the caller's context
+    SCHEMATIC* schematic = ( aDepth == 0 && HasTextVars() ) ? Schematic() : nullptr;
+    wxString   text;
+
+    if( schematic && schematic->GetCachedShownText( this, aPath, aAllowExtraText, &text ) )
+        return text;
+
+    text = EDA_TEXT::GetShownText( aAllowExtraText, aDepth );
 
     if( text == wxS( "~" ) ) // Legacy placeholder for empty string
     {
@@ -885,6 +892,9 @@ wxString SCH_LABEL_BASE::GetShownText( const SCH_SHEET_PATH* aPath, bool aAllowE
             text = ExpandTextVars( text, &textResolver );
     }
 
+    if( schematic )
+        schematic->CacheShownText( this, aPath, aAllowExtraText, text );
+
     return text;
 }
 
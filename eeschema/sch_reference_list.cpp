@@ -240,49 +240,17 @@ std::vector<int> SCH_REFERENCE_LIST::GetUnitsMatchingRef( const SCH_REFERENCE& a
 int SCH_REFERENCE_LIST::FindFirstUnusedReference( const SCH_REFERENCE& aRef, int aMinValue,
                                                   const std::vector<int>& aRequiredUnits ) const
 {
-    // Create a map of references indexed by reference number, only including those with the same
-    // reference prefix as aRef
-    std::map<int, std::vector<SCH_REFERENCE>> refNumberMap;
+    // Index the reference numbers in use, only including those with the same reference prefix
+    // as aRef
+    REF_NUMBER_INDEX refNumbers;
 
-    for( const SCH_REFERENCE& ref : m_flatList )
+    for( unsigned ii = 0; ii < m_flatList.size(); ++ii )
     {
-        // search only for the current reference prefix:
-        if( ref.CompareRef( aRef ) != 0 )
-            continue;
-
-        if( ref.m_isNew )
-            continue; // It will be reannotated
-
-        refNumberMap[ref.m_numRef].push_back( ref );
-    }
-
-    // Start at the given minimum value
-    int minFreeNumber = aMinValue;
-
-    for( ; refNumberMap[minFreeNumber].size() > 0; ++minFreeNumber )
-    {
-        auto isNumberInUse = [&]() -> bool
-                             {
-                                for( const int& unit : aRequiredUnits )
-                                {
-                                    for( const SCH_REFERENCE& ref : refNumberMap[minFreeNumber] )
-                                    {
-                                        if( ref.CompareLibName( aRef ) || ref.CompareValue( aRef )
-                                            || ref.GetUnit() == unit )
-                                        {
-                                            return true;
-                                        }
-                                    }
-                                }
-
-                                return false;
-                             };
-
-        if( !isNumberInUse() )
-            return minFreeNumber;
+        if( m_flatList[ii].CompareRef( aRef ) == 0 )
+            addRefNumber( refNumbers, ii );
     }
 
-    return minFreeNumber;
+    return findFirstUnusedReference( refNumbers, aRef, aMinValue, aRequiredUnits );
 }
 
 
@@ -304,38 +272,153 @@ std::vector<SCH_SYMBOL_INSTANCE> SCH_REFERENCE_LIST::GetSymbolInstances() const
 }
 
 
-int SCH_REFERENCE_LIST::createFirstFreeRefId( std::vector<int>& aIdList, int aFirstValue )
+void SCH_REFERENCE_LIST::addRefNumber( REF_NUMBER_INDEX& aRefNumbers, unsigned aIndex ) const
 {
-    int expectedId = aFirstValue;
+    const SCH_REFERENCE& ref = m_flatList[aIndex];
+
+    if( ref.m_isNew )
+        return; // It will be reannotated
 
-    // We search for expected Id a value >= aFirstValue.
-    // Skip existing Id < aFirstValue
-    unsigned ii = 0;
+    REF_NUMBERS&           numbers = aRefNumbers[ref.m_ref.Lower()];
+    std::vector<unsigned>& refs = numbers.m_refs[ref.m_numRef];
 
-    for( ; ii < aIdList.size(); ii++ )
+    refs.push_back( aIndex );
+
+    if( refs.size() > 1 )
+        return;
+
+    // A new number: extend or merge the runs around it
+    std::map<int, int>& ranges = numbers.m_ranges;
+    int                 num = ref.m_numRef;
+    auto                next = ranges.upper_bound( num );
+    auto                prev = next == ranges.begin() ? ranges.end() : std::prev( next );
+    bool                joinPrev = prev != ranges.end() && prev->second == num - 1;
+    bool                joinNext = next != ranges.end() && next->first == num + 1;
+
+    if( joinPrev && joinNext )
     {
-        if( expectedId <= aIdList[ii] )
-            break;
+        prev->second = next->second;
+        ranges.erase( next );
+    }
+    else if( joinPrev )
+    {
+        prev->second = num;
     }
+    else if( joinNext )
+    {
+        int last = next->second;
+        ranges.erase( next );
+        ranges[num] = last;
+    }
+    else
+    {
+        ranges[num] = num;
+    }
+}
+
+
+void SCH_REFERENCE_LIST::removeRefNumber( REF_NUMBER_INDEX& aRefNumbers, unsigned aIndex ) const
+{
+    const SCH_REFERENCE& ref = m_flatList[aIndex];
+
+    if( ref.m_isNew )
+        return;
+
+    auto numbersIt = aRefNumbers.find( ref.m_ref.Lower() );
+
+    if( numbersIt == aRefNumbers.end() )
+        return;
+
+    REF_NUMBERS& numbers = numbersIt->second;
+    auto         refsIt = numbers.m_refs.find( ref.m_numRef );
+
+    if( refsIt == numbers.m_refs.end() )
+        return;
+
+    alg::delete_matching( refsIt->second, aIndex );
+
+    if( !refsIt->second.empty() )
+        return;
+
+    numbers.m_refs.erase( refsIt );
+
+    // The number is free again: split the run holding it
+    int  num = ref.m_numRef;
+    auto range = std::prev( numbers.m_ranges.upper_bound( num ) );
+    int  first = range->first;
+    int  last = range->second;
 
-    // Ids are sorted by increasing value, from aFirstValue
-    // So we search from aFirstValue the first not used value, i.e. the first hole in list.
-    for( ; ii < aIdList.size(); ii++ )
+    numbers.m_ranges.erase( range );
+
+    if( first < num )
+        numbers.m_ranges[first] = num - 1;
+
+    if( num < last )
+        numbers.m_ranges[num + 1] = last;
+}
+
+
+int SCH_REFERENCE_LIST::firstFreeRefId( const REF_NUMBER_INDEX& aRefNumbers,
+                                        const wxString& aPrefix, int aFirstValue )
+{
+    auto numbersIt = aRefNumbers.find( aPrefix.Lower() );
+
+    if( numbersIt == aRefNumbers.end() )
+        return aFirstValue;
+
+    // Runs are merged, so the number following the run holding aFirstValue is free
+    const std::map<int, int>& ranges = numbersIt->second.m_ranges;
+    auto                      range = ranges.upper_bound( aFirstValue );
+
+    if( range == ranges.begin() )
+        return aFirstValue;
+
+    --range;
+
+    return range->second >= aFirstValue ? range->second + 1 : aFirstValue;
+}
+
+
+int SCH_REFERENCE_LIST::findFirstUnusedReference( const REF_NUMBER_INDEX& aRefNumbers,
+                                                  const SCH_REFERENCE& aRef, int aMinValue,
+                                                  const std::vector<int>& aRequiredUnits ) const
+{
+    // Start at the given minimum value
+    int  minFreeNumber = aMinValue;
+    auto numbersIt = aRefNumbers.find( aRef.m_ref.Lower() );
+
+    if( numbersIt == aRefNumbers.end() )
+        return minFreeNumber;
+
+    const std::map<int, std::vector<unsigned>>& refNumberMap = numbersIt->second.m_refs;
+
+    for( auto it = refNumberMap.find( minFreeNumber );
+         it != refNumberMap.end() && it->first == minFreeNumber; ++it, ++minFreeNumber )
     {
-        if( expectedId != aIdList[ii] )    // This id is not yet used.
-        {
-            // Insert this free Id, in order to keep list sorted
-            aIdList.insert( aIdList.begin() + ii, expectedId );
-            return expectedId;
-        }
+        auto isNumberInUse = [&]() -> bool
+                             {
+                                for( const int& unit : aRequiredUnits )
+                                {
+                                    for( unsigned refIndex : it->second )
+                                    {
+                                        const SCH_REFERENCE& ref = m_flatList[refIndex];
+
+                                        if( ref.CompareLibName( aRef ) || ref.CompareValue( aRef )
+                                            || ref.GetUnit() == unit )
+                                        {
+                                            return true;
+                                        }
+                                    }
+                                }
 
-        expectedId++;
+                                return false;
+                             };
+
+        if( !isNumberInUse() )
+            return minFreeNumber;
     }
 
-    // All existing Id are tested, and all values are found in use.
-    // So Create a new one.
-    aIdList.push_back( expectedId );
-    return expectedId;
+    return minFreeNumber;
 }
 
 
@@ -479,6 +562,31 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         AddItem( additionalRef ); //add to this container
     }
 
+    // Index the list once: the reference numbers in use for each prefix, the references of each
+    // symbol and the locked units of each symbol.  Scanning the list for each symbol instead
+    // makes annotating large designs quadratic.
+    REF_NUMBER_INDEX                                         refNumbers;
+    std::unordered_map<SCH_SYMBOL*, std::vector<unsigned>>   symbolRefs;
+    std::unordered_map<SCH_SYMBOL*,
+                       std::vector<std::pair<KIID_PATH, SCH_REFERENCE_LIST*>>> lockedLists;
+
+    for( unsigned ii = 0; ii < m_flatList.size(); ii++ )
+    {
+        addRefNumber( refNumbers, ii );
+        symbolRefs[m_flatList[ii].GetSymbol()].push_back( ii );
+    }
+
+    for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+    {
+        for( unsigned thisRefI = 0; thisRefI < pair.second.GetCount(); ++thisRefI )
+        {
+            SCH_REFERENCE& thisRef = pair.second[thisRefI];
+
+            lockedLists[thisRef.GetSymbol()].emplace_back( thisRef.GetSheetPath().Path(),
+                                                           &pair.second );
+        }
+    }
+
     int LastReferenceNumber = 0;
 
     /* calculate index of the first symbol with the same reference prefix
@@ -507,24 +615,18 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
         // Check whether this symbol is in aLockedUnitMap.
         SCH_REFERENCE_LIST* lockedList = nullptr;
+        auto                lockedIt = lockedLists.find( ref_unit.GetSymbol() );
 
-        for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+        if( lockedIt != lockedLists.end() )
         {
-            unsigned n_refs = pair.second.GetCount();
-
-            for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
+            for( const auto& [path, list] : lockedIt->second )
             {
-                SCH_REFERENCE &thisRef = pair.second[thisRefI];
-
-                if( thisRef.IsSameInstance( ref_unit ) )
+                if( path == ref_unit.GetSheetPath().Path() )
                 {
-                    lockedList = &pair.second;
+                    lockedList = list;
                     break;
                 }
             }
-
-            if( lockedList != nullptr )
-                break;
         }
 
         if(  ( m_flatList[first].CompareRef( ref_unit ) != 0 )
@@ -551,15 +653,14 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         {
             if( ref_unit.m_isNew )
             {
-                std::vector<int> idList;
-                GetRefsInUse( first, idList, minRefId );
-                LastReferenceNumber = createFirstFreeRefId( idList, minRefId );
+                LastReferenceNumber = firstFreeRefId( refNumbers, ref_unit.m_ref, minRefId );
                 ref_unit.m_numRef = LastReferenceNumber;
                 ref_unit.m_numRefStr = wxString::Format( "%d", LastReferenceNumber );
+                ref_unit.m_isNew = false;
+                addRefNumber( refNumbers, ii );
             }
 
             ref_unit.m_flag  = 1;
-            ref_unit.m_isNew = false;
             continue;
         }
 
@@ -572,11 +673,13 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
             if( ref_unit.m_isNew )
             {
-                LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, units );
+                LastReferenceNumber = findFirstUnusedReference( refNumbers, ref_unit, minRefId,
+                                                                units );
                 ref_unit.m_numRef = LastReferenceNumber;
                 ref_unit.m_numRefStr = wxString::Format( "%d", LastReferenceNumber );
                 ref_unit.m_isNew = false;
                 ref_unit.m_flag = 1;
+                addRefNumber( refNumbers, ii );
             }
 
             for( unsigned lockedRefI = 0; lockedRefI < n_refs; ++lockedRefI )
@@ -599,9 +702,9 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     continue;
 
                 // Find the matching symbol
-                for( unsigned jj = ii + 1; jj < m_flatList.size(); jj++ )
+                for( unsigned jj : symbolRefs[lockedRef.GetSymbol()] )
                 {
-                    if( !lockedRef.IsSameInstance( m_flatList[jj] ) )
+                    if( jj <= ii || !lockedRef.IsSameInstance( m_flatList[jj] ) )
                         continue;
 
                     wxString ref_candidate = buildFullReference( ref_unit, lockedRef.m_unit );
@@ -611,10 +714,12 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     // multiunits symbols have duplicate references)
                     if( inUseRefs.find( ref_candidate ) == inUseRefs.end() )
                     {
+                        removeRefNumber( refNumbers, jj );
                         m_flatList[jj].m_numRef = ref_unit.m_numRef;
                         m_flatList[jj].m_numRefStr = ref_unit.m_numRefStr;
                         m_flatList[jj].m_isNew = false;
                         m_flatList[jj].m_flag = 1;
+                        addRefNumber( refNumbers, jj );
 
                         // lock this new full reference
                         inUseRefs.insert( ref_candidate );
@@ -629,10 +734,12 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             // know what group this might belong to, so just find the first unused reference for
             // this specific unit. The other units will be annotated in the following passes.
             std::vector<int> units = { ref_unit.GetUnit() };
-            LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, units );
+            LastReferenceNumber = findFirstUnusedReference( refNumbers, ref_unit, minRefId,
+                                                            units );
             ref_unit.m_numRef = LastReferenceNumber;
             ref_unit.m_isNew = false;
             ref_unit.m_flag = 1;
+            addRefNumber( refNumbers, ii );
         }
     }
 
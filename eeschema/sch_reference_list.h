@@ -27,6 +27,7 @@
 #define _SCH_REFERENCE_LIST_H_
 
 #include <map>
+#include <unordered_map>
 
 #include <lib_symbol.h>
 #include <macros.h>
@@ -604,18 +605,42 @@ private:
     static bool sortByReferenceOnly( const SCH_REFERENCE& item1, const SCH_REFERENCE& item2 );
 
     /**
-     * Search for the first free reference number in \a aListId of reference numbers in use.
+     * The reference numbers in use for a reference prefix.
      *
-     * This function just searches for a hole in a list of incremented numbers, this list must
-     * be sorted by increasing values and each value can be stored only once.  The new value
-     * is added to the list.
-     *
-     * @see BuildRefIdInUseList to prepare this list
-     * @param aIdList The buffer that contains the reference numbers in use.
-     * @param aFirstValue The first expected free value
-     * @return The first free (not yet used) value.
+     * Annotate() keeps these up to date while it assigns numbers, so it doesn't have to scan
+     * the whole list for each symbol to find a free number.
+     */
+    struct REF_NUMBERS
+    {
+        std::map<int, std::vector<unsigned>> m_refs;    ///< List indexes by reference number
+        std::map<int, int>                   m_ranges;  ///< Runs of used numbers (first, last)
+    };
+
+    /// Reference numbers in use, by lower case reference prefix
+    typedef std::unordered_map<wxString, REF_NUMBERS> REF_NUMBER_INDEX;
+
+    /**
+     * Add the reference at \a aIndex to \a aRefNumbers, unless it is not annotated yet.
+     */
+    void addRefNumber( REF_NUMBER_INDEX& aRefNumbers, unsigned aIndex ) const;
+
+    /**
+     * Remove the reference at \a aIndex from \a aRefNumbers, before changing its number.
+     */
+    void removeRefNumber( REF_NUMBER_INDEX& aRefNumbers, unsigned aIndex ) const;
+
+    /**
+     * Return the first reference number >= \a aFirstValue not used by a reference with the
+     * prefix \a aPrefix.
+     */
+    static int firstFreeRefId( const REF_NUMBER_INDEX& aRefNumbers, const wxString& aPrefix,
+                               int aFirstValue );
+
+    /**
+     * Same as FindFirstUnusedReference() for the numbers of \a aRefNumbers.
      */
-    static int createFirstFreeRefId( std::vector<int>& aIdList, int aFirstValue );
+    int findFirstUnusedReference( const REF_NUMBER_INDEX& aRefNumbers, const SCH_REFERENCE& aRef,
+                                  int aMinValue, const std::vector<int>& aRequiredUnits ) const;
 
     // Used for sorting static sortByTimeStamp function
     friend class BACK_ANNOTATE;
@@ -1396,10 +1396,42 @@ std::vector<VECTOR2I> SCH_SCREEN::GetConnections() const
 }
 
 
+std::vector<VECTOR2I> SCH_SCREEN::GetConnectionsOnSegment( const VECTOR2I& aStart,
+                                                            const VECTOR2I& aEnd ) const
+{
+    std::vector<VECTOR2I> retval;
+    BOX2I                 bbox( aStart, aEnd - aStart );
+
+    bbox.Normalize();
+    bbox.Inflate( 1 );
+
+    for( SCH_ITEM* item : Items().Overlapping( bbox ) )
+    {
+        // Avoid items that are changing
+        if( item->GetEditFlags() & ( IS_MOVING | IS_DELETED ) )
+            continue;
+
+        for( const VECTOR2I& pt : item->GetConnectionPoints() )
+        {
+            if( IsPointOnSegment( aStart, aEnd, pt ) )
+                retval.push_back( pt );
+        }
+    }
+
+    std::sort( retval.begin(), retval.end(),
+               []( const VECTOR2I& a, const VECTOR2I& b ) -> bool
+               {
+                   return a.x < b.x || ( a.x == b.x && a.y < b.y );
+               } );
+    retval.erase( std::unique( retval.begin(), retval.end() ), retval.end() );
+
+    return retval;
+}
+
+
 std::vector<VECTOR2I> SCH_SCREEN::GetNeededJunctions( const std::deque<EDA_ITEM*>& aItems ) const
 {
     std::vector<VECTOR2I> pts;
-    std::vector<VECTOR2I> connections = GetConnections();
 
     for( const EDA_ITEM* edaItem : aItems )
     {
@@ -1415,13 +1447,10 @@ std::vector<VECTOR2I> SCH_SCREEN::GetNeededJunctions( const std::deque<EDA_ITEM*
         // that terminate on the line after it is moved.
         if( item->Type() == SCH_LINE_T )
         {
-            SCH_LINE* line = (SCH_LINE*) item;
+            const SCH_LINE* line = static_cast<const SCH_LINE*>( item );
 
-            for( const VECTOR2I& pt : connections )
-            {
-                if( IsPointOnSegment( line->GetStartPoint(), line->GetEndPoint(), pt ) )
-                    pts.push_back( pt );
-            }
+            new_pts = GetConnectionsOnSegment( line->GetStartPoint(), line->GetEndPoint() );
+            pts.insert( pts.end(), new_pts.begin(), new_pts.end() );
         }
     }
 
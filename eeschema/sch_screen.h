@@ -454,6 +454,15 @@ public:
      */
     std::vector<VECTOR2I> GetConnections() const;
 
+    /**
+     * Collect a unique list of the connection points lying on the segment from \a aStart to
+     * \a aEnd.  Only the items near the segment are visited.
+     *
+     * @return vector of connections
+     */
+    std::vector<VECTOR2I> GetConnectionsOnSegment( const VECTOR2I& aStart,
+                                                   const VECTOR2I& aEnd ) const;
+
     /**
      * Return the unique set of points belonging to aItems where a junction is needed.
      *
@@ -41,6 +41,7 @@
 #include <sch_plotter.h>
 #include <string_utils.h>
 
+#include <mutex>
 #include <utility>
 
 
@@ -1418,7 +1419,17 @@ bool SCH_SYMBOL::ResolveTextVar( const SCH_SHEET_PATH* aPath, wxString* token, i
     if( !schematic )
         return false;
 
-    if( operatingPoint.Matches( *token ) )
+    // Fields are resolved from several threads at once (see the BOM export), but wxRegEx keeps
+    // the state of its last match and the simulation models are created on the fly.  Only
+    // operating point variables need them, so only these are done one at a time.
+    static std::recursive_mutex            operatingPointMutex;
+    std::unique_lock<std::recursive_mutex> operatingPointLock( operatingPointMutex,
+                                                               std::defer_lock );
+
+    if( token->StartsWith( wxS( "OP" ) ) )
+        operatingPointLock.lock();
+
+    if( operatingPointLock.owns_lock() && operatingPoint.Matches( *token ) )
     {
         wxString pin( operatingPoint.GetMatch( *token, 1 ).Lower() );
         wxString precisionStr( operatingPoint.GetMatch( *token, 3 ) );
@@ -25,6 +25,7 @@
 #include <ee_collectors.h>
 #include <erc/erc_settings.h>
 #include <font/outline_font.h>
+#include <hash.h>
 #include <netlist_exporter_spice.h>
 #include <project.h>
 #include <project/net_settings.h>
@@ -45,7 +46,8 @@ bool SCHEMATIC::m_IsSchematicExists = false;
 SCHEMATIC::SCHEMATIC( PROJECT* aPrj ) :
           EDA_ITEM( nullptr, SCHEMATIC_T ),
           m_project( nullptr ),
-          m_rootSheet( nullptr )
+          m_rootSheet( nullptr ),
+          m_shownTextCacheUsers( 0 )
 {
     m_currentSheet    = new SCH_SHEET_PATH();
     m_connectionGraph = new CONNECTION_GRAPH( this );
@@ -158,6 +160,8 @@ void SCHEMATIC::Reset()
 
     m_connectionGraph->Reset();
     m_currentSheet->clear();
+
+    InvalidateShownTextCache();
 }
 
 
@@ -201,6 +205,67 @@ void SCHEMATIC::SetRoot( SCH_SHEET* aRootSheet )
     m_currentSheet->push_back( m_rootSheet );
 
     m_connectionGraph->Reset();
+
+    InvalidateShownTextCache();
+}
+
+
+size_t SCHEMATIC::SHOWN_TEXT_KEY_HASH::operator()( const SHOWN_TEXT_KEY& aKey ) const
+{
+    return hash_val( aKey.m_item, aKey.m_pathHash, aKey.m_allowExtraText );
+}
+
+
+void SCHEMATIC::EnableShownTextCache( bool aEnable )
+{
+    if( aEnable )
+    {
+        m_shownTextCacheUsers++;
+    }
+    else if( --m_shownTextCacheUsers == 0 )
+    {
+        // Nothing invalidates the cache while it is disabled, so it must not survive
+        InvalidateShownTextCache();
+    }
+}
+
+
+bool SCHEMATIC::GetCachedShownText( const EDA_ITEM* aItem, const SCH_SHEET_PATH* aPath,
+                                    bool aAllowExtraText, wxString* aText ) const
+{
+    if( m_shownTextCacheUsers == 0 )
+        return false;
+
+    std::lock_guard<std::mutex> lock( m_shownTextCacheMutex );
+
+    auto it = m_shownTextCache.find( { aItem, aPath ? aPath->GetCurrentHash() : 0,
+                                       aAllowExtraText } );
+
+    if( it == m_shownTextCache.end() )
+        return false;
+
+    *aText = it->second;
+    return true;
+}
+
+
+void SCHEMATIC::CacheShownText( const EDA_ITEM* aItem, const SCH_SHEET_PATH* aPath,
+                                bool aAllowExtraText, const wxString& aText ) const
+{
+    if( m_shownTextCacheUsers == 0 )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_shownTextCacheMutex );
+
+    m_shownTextCache[{ aItem, aPath ? aPath->GetCurrentHash() : 0, aAllowExtraText }] = aText;
+}
+
+
+void SCHEMATIC::InvalidateShownTextCache()
+{
+    std::lock_guard<std::mutex> lock( m_shownTextCacheMutex );
+
+    m_shownTextCache.clear();
 }
 
 
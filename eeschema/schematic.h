@@ -25,6 +25,10 @@
 #include <sch_sheet_path.h>
 #include <schematic_settings.h>
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
 
 class BUS_ALIAS;
 class CONNECTION_GRAPH;
@@ -138,6 +142,32 @@ public:
 
     bool ResolveTextVar( const SCH_SHEET_PATH* aSheetPath, wxString* token, int aDepth ) const;
 
+    /**
+     * Enable or disable the shown text cache.  Calls are counted, so the cache stays enabled
+     * until each enabling call has been matched.  See SHOWN_TEXT_CACHE_ENABLER.
+     *
+     * While enabled, labels and fields containing text variables keep their expanded text per
+     * sheet path.  ERC and the netlist exporters ask for the same texts many times.
+     */
+    void EnableShownTextCache( bool aEnable );
+
+    /**
+     * Look up the cached shown text of \a aItem on \a aPath.
+     *
+     * @return false if the cache is disabled or doesn't hold this text.
+     */
+    bool GetCachedShownText( const EDA_ITEM* aItem, const SCH_SHEET_PATH* aPath,
+                             bool aAllowExtraText, wxString* aText ) const;
+
+    void CacheShownText( const EDA_ITEM* aItem, const SCH_SHEET_PATH* aPath, bool aAllowExtraText,
+                         const wxString& aText ) const;
+
+    /**
+     * Clear the shown text cache.  Must be called whenever an item, a text variable or the
+     * connectivity (which some text variables refer to) changes.
+     */
+    void InvalidateShownTextCache();
+
     /// Helper to retrieve the filename from the root sheet screen
     wxString GetFileName() const override;
 
@@ -235,6 +265,7 @@ public:
     void ClearOperatingPoints()
     {
         m_operatingPoints.clear();
+        InvalidateShownTextCache();
     }
 
     /**
@@ -243,6 +274,7 @@ public:
     void SetOperatingPoint( const wxString& aSignal, double aValue )
     {
         m_operatingPoints[ aSignal ] = aValue;
+        InvalidateShownTextCache();
     }
 
     wxString GetOperatingPoint( const wxString& aNetName, int aPrecision, const wxString& aRange );
@@ -369,6 +401,51 @@ private:
      * Currently installed listeners
      */
     std::vector<SCHEMATIC_LISTENER*> m_listeners;
+
+    struct SHOWN_TEXT_KEY
+    {
+        const EDA_ITEM* m_item;
+        size_t          m_pathHash;
+        bool            m_allowExtraText;
+
+        bool operator==( const SHOWN_TEXT_KEY& aOther ) const = default;
+    };
+
+    struct SHOWN_TEXT_KEY_HASH
+    {
+        size_t operator()( const SHOWN_TEXT_KEY& aKey ) const;
+    };
+
+    /// Shown text cache, see EnableShownTextCache().  Filled from several threads during ERC
+    /// and connectivity calculations.
+    std::atomic<int>   m_shownTextCacheUsers;
+    mutable std::mutex m_shownTextCacheMutex;
+
+    mutable std::unordered_map<SHOWN_TEXT_KEY, wxString, SHOWN_TEXT_KEY_HASH> m_shownTextCache;
+};
+
+
+/**
+ * Enable the shown text cache of a schematic for the lifetime of this object.
+ */
+class SHOWN_TEXT_CACHE_ENABLER
+{
+public:
+    SHOWN_TEXT_CACHE_ENABLER( SCHEMATIC* aSchematic ) :
+            m_schematic( aSchematic )
+    {
+        if( m_schematic )
+            m_schematic->EnableShownTextCache( true );
+    }
+
+    ~SHOWN_TEXT_CACHE_ENABLER()
+    {
+        if( m_schematic )
+            m_schematic->EnableShownTextCache( false );
+    }
+
+private:
+    SCHEMATIC* m_schematic;
 };
 
 #endif
@@ -40,6 +40,8 @@
 #include <connection_graph.h>
 #include <wx/log.h>
 
+#include <unordered_map>
+
 
 BACK_ANNOTATE::BACK_ANNOTATE( SCH_EDIT_FRAME* aFrame, REPORTER& aReporter, bool aRelinkFootprints,
                               bool aProcessFootprints, bool aProcessValues,
@@ -260,48 +262,54 @@ void BACK_ANNOTATE::getPcbModulesFromString( const std::string& aPayload )
 
 void BACK_ANNOTATE::getChangeList()
 {
+    // Index the symbols by the key the footprints are matched with.  Searching the reference
+    // lists for each footprint is quadratic, which is very slow on large designs.
+    auto refKey = [&]( const SCH_REFERENCE& aRef ) -> wxString
+                  {
+                      return m_matchByReference ? aRef.GetRef() : aRef.GetFullPath();
+                  };
+
+    std::unordered_map<wxString, SCH_REFERENCE_LIST*> multiUnitsRefs;
+    std::unordered_map<wxString, int>                 refIndexes;
+
+    for( std::pair<const wxString, SCH_REFERENCE_LIST>& item : m_multiUnitsRefs )
+    {
+        SCH_REFERENCE_LIST& refList = item.second;
+
+        for( size_t i = 0; i < refList.GetCount(); ++i )
+            multiUnitsRefs.emplace( refKey( refList[i] ), &refList );
+    }
+
+    for( size_t i = 0; i < m_refs.GetCount(); ++i )
+        refIndexes.emplace( refKey( m_refs[i] ), static_cast<int>( i ) );
+
     for( std::pair<const wxString, std::shared_ptr<PCB_FP_DATA>>& fpData : m_pcbFootprints )
     {
         const wxString& pcbPath = fpData.first;
         auto&           pcbData = fpData.second;
-        int             refIndex;
-        bool            foundInMultiunit = false;
+        auto            multiUnitIt = multiUnitsRefs.find( pcbPath );
 
-        for( std::pair<const wxString, SCH_REFERENCE_LIST>& item : m_multiUnitsRefs )
+        if( multiUnitIt != multiUnitsRefs.end() )
         {
-            SCH_REFERENCE_LIST& refList = item.second;
+            // If footprint linked to multi unit symbol, we add all symbol's units to
+            // the change list
+            SCH_REFERENCE_LIST& refList = *multiUnitIt->second;
 
-            if( m_matchByReference )
-                refIndex = refList.FindRef( pcbPath );
-            else
-                refIndex = refList.FindRefByFullPath( pcbPath );
-
-            if( refIndex >= 0 )
+            for( size_t i = 0; i < refList.GetCount(); ++i )
             {
-                // If footprint linked to multi unit symbol, we add all symbol's units to
-                // the change list
-                foundInMultiunit = true;
-
-                for( size_t i = 0; i < refList.GetCount(); ++i )
-                {
-                    refList[ i ].GetSymbol()->ClearFlags(SKIP_STRUCT );
-                    m_changelist.emplace_back( CHANGELIST_ITEM( refList[i], pcbData ) );
-                }
-
-                break;
+                refList[ i ].GetSymbol()->ClearFlags(SKIP_STRUCT );
+                m_changelist.emplace_back( CHANGELIST_ITEM( refList[i], pcbData ) );
             }
-        }
 
-        if( foundInMultiunit )
             continue;
+        }
 
-        if( m_matchByReference )
-            refIndex = m_refs.FindRef( pcbPath );
-        else
-            refIndex = m_refs.FindRefByFullPath( pcbPath );
+        auto refIt = refIndexes.find( pcbPath );
 
-        if( refIndex >= 0 )
+        if( refIt != refIndexes.end() )
         {
+            int refIndex = refIt->second;
+
             m_refs[ refIndex ].GetSymbol()->ClearFlags( SKIP_STRUCT );
             m_changelist.emplace_back( CHANGELIST_ITEM( m_refs[refIndex], pcbData ) );
         }
@@ -1177,8 +1177,6 @@ void SCH_LINE_WIRE_BUS_TOOL::finishSegments()
     // Remove segments backtracking over others
     simplifyWireList();
 
-    // Collect the possible connection points for the new lines
-    std::vector<VECTOR2I> connections = screen->GetConnections();
     std::vector<VECTOR2I> new_ends;
 
     // Check each new segment for possible junctions and add/split if needed
@@ -1191,11 +1189,9 @@ void SCH_LINE_WIRE_BUS_TOOL::finishSegments()
 
         new_ends.insert( new_ends.end(), tmpends.begin(), tmpends.end() );
 
-        for( const VECTOR2I& pt : connections )
-        {
-            if( IsPointOnSegment( wire->GetStartPoint(), wire->GetEndPoint(), pt ) )
-                new_ends.push_back( pt );
-        }
+        // Add the connection points of the schematic lying on the new segment
+        tmpends = screen->GetConnectionsOnSegment( wire->GetStartPoint(), wire->GetEndPoint() );
+        new_ends.insert( new_ends.end(), tmpends.begin(), tmpends.end() );
 
         commit.Added( wire, screen );
     }
@@ -0,0 +1,192 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gal/gal.h>
+#include <geometry/eda_angle.h>
+#include <font/outline_decomposer.h>
+
+class wxString;
+
+namespace KIFONT
+{
+
+/**
+ * Identifies a decomposed outline font glyph.
+ */
+struct GLYPH_CACHE_KEY
+{
+    uint32_t    fontId;         ///< From GLYPH_CACHE::GetFontId()
+    uint32_t    codepoint;
+    double      scaler;
+    bool        fakeItalic;
+    bool        fakeBold;
+    bool        mirror;
+    EDA_ANGLE   angle;
+
+    bool operator==( const GLYPH_CACHE_KEY& rhs ) const
+    {
+        return fontId == rhs.fontId && codepoint == rhs.codepoint && scaler == rhs.scaler
+                   && fakeItalic == rhs.fakeItalic && fakeBold == rhs.fakeBold
+                   && mirror == rhs.mirror && angle == rhs.angle;
+    }
+};
+
+} // namespace KIFONT
+
+
+namespace std
+{
+    template <>
+    struct hash<KIFONT::GLYPH_CACHE_KEY>
+    {
+        std::size_t operator()( const KIFONT::GLYPH_CACHE_KEY& k ) const
+        {
+            return hash<uint32_t>()( k.fontId ) ^ ( hash<uint32_t>()( k.codepoint ) << 1 )
+                        ^ hash<double>()( k.scaler )
+                        ^ hash<int>()( k.fakeItalic ) ^ hash<int>()( k.fakeBold )
+                        ^ hash<int>()( k.mirror ) ^ hash<int>()( k.angle.AsTenthsOfADegree() );
+        }
+    };
+}
+
+
+namespace KIFONT
+{
+
+/**
+ * Process-wide cache of decomposed outline font glyphs (contours and triangulation hints).
+ *
+ * The cache is safe to use from several threads, holds at most a fixed number of glyphs
+ * (least recently used ones are dropped first) and can be saved to and restored from a file
+ * so that glyphs do not have to be decomposed and triangulated again in the next session.
+ * The entries are spread over several independently locked shards, so threads drawing text
+ * at the same time rarely wait for each other.
+ *
+ * Entries are immutable once stored; updating a glyph means storing a new entry.
+ */
+class GAL_API GLYPH_CACHE
+{
+public:
+    static GLYPH_CACHE& GetInstance();
+
+    /**
+     * Return the id identifying a font in cache keys.  Call it once per font face and keep the
+     * result.
+     *
+     * @param aFontName identifies the font with a string that stays the same across sessions
+     *                  (see OUTLINE_FONT::loadFace()), so entries can be persisted.
+     * @return a non-zero id.
+     */
+    uint32_t GetFontId( const std::string& aFontName );
+
+    /**
+     * @return the cached glyph data, or nullptr if \a aKey is not in the cache.
+     */
+    std::shared_ptr<const GLYPH_DATA> Get( const GLYPH_CACHE_KEY& aKey );
+
+    /**
+     * Store (or replace) the glyph data for \a aKey.
+     */
+    void Put( const GLYPH_CACHE_KEY& aKey, std::shared_ptr<const GLYPH_DATA> aData );
+
+    void Clear();
+
+    size_t GetSize() const;
+
+    size_t GetMaxSize() const { return m_maxSize; }
+    void SetMaxSize( size_t aMaxSize );
+
+    /**
+     * Load glyphs saved by Save() into the cache.  Unreadable, outdated or corrupt files are
+     * ignored.
+     *
+     * @return true if the file was read.
+     */
+    bool Load( const wxString& aFileName );
+
+    /**
+     * Save the cached glyphs to \a aFileName, if any glyph was added since the last Load() or
+     * Save().  The file is replaced atomically.
+     *
+     * @return true if the file was written or did not need to be.
+     */
+    bool Save( const wxString& aFileName );
+
+    /**
+     * @return the file used to persist the cache in the user cache directory.
+     */
+    static wxString GetDefaultCacheFile();
+
+private:
+    GLYPH_CACHE();
+
+    typedef std::list<GLYPH_CACHE_KEY> LRU_LIST;
+
+    struct ENTRY
+    {
+        std::shared_ptr<const GLYPH_DATA> m_data;
+        LRU_LIST::iterator                m_lruPos;
+    };
+
+    struct SHARD
+    {
+        std::mutex                                 m_mutex;
+        std::unordered_map<GLYPH_CACHE_KEY, ENTRY> m_entries;
+        LRU_LIST                                   m_lru;        ///< Most recently used first
+    };
+
+    static constexpr size_t SHARD_COUNT = 16;
+
+    SHARD& shard( const GLYPH_CACHE_KEY& aKey );
+
+    ///< Drop least recently used entries until \a aShard fits.  Its lock must be held.
+    void trim( SHARD& aShard );
+
+    /// The number of glyphs each shard may hold.
+    size_t shardMaxSize() const;
+
+    mutable std::array<SHARD, SHARD_COUNT>    m_shards;
+    std::atomic<size_t>                       m_maxSize;
+    std::atomic<bool>                         m_modified;
+
+    std::mutex                                m_fontMutex;
+    std::vector<std::string>                  m_fontNames;  ///< Indexed by font id - 1
+    std::unordered_map<std::string, uint32_t> m_fontIds;
+};
+
+} // namespace KIFONT
+
+#endif // GLYPH_CACHE_H
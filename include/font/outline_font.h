@@ -130,14 +130,6 @@ protected:
                               const VECTOR2I& aPosition, const EDA_ANGLE& aAngle, bool aMirror,
                               const VECTOR2I& aOrigin, TEXT_STYLE_FLAGS aTextStyle ) const;
 
-private:
-    VECTOR2I getTextAsGlyphsUnlocked( BOX2I* aBoundingBox,
-                                      std::vector<std::unique_ptr<GLYPH>>* aGlyphs,
-                                      const wxString& aText, const VECTOR2I& aSize,
-                                      const VECTOR2I& aPosition, const EDA_ANGLE& aAngle,
-                                      bool aMirror, const VECTOR2I& aOrigin,
-                                      TEXT_STYLE_FLAGS aTextStyle ) const;
-
 private:
     // FreeType variables
 
@@ -152,9 +144,8 @@ private:
     bool              m_fakeBold;
     bool              m_fakeItal;
 
-    // cache for glyphs converted to straight segments
-    // key is glyph index (FT_GlyphSlot field glyph_index)
-    std::map<unsigned int, std::vector<std::vector<VECTOR2D>>> m_contourCache;
+    // Identifies this face in the GLYPH_CACHE
+    uint32_t          m_glyphCacheId;
 
     // The height of the KiCad stroke font is the distance between stroke endpoints for a vertical
     // line of cap-height.  So the cap-height of the font is actually stroke-width taller than its
@@ -0,0 +1,115 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef STROKE_TEXT_CACHE_H
+#define STROKE_TEXT_CACHE_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <core/wx_stl_compat.h>
+#include <gal/gal.h>
+#include <font/text_attributes.h>
+#include <geometry/geometry_utils.h>
+#include <geometry/seg.h>
+#include <geometry/shape_poly_set.h>
+
+namespace KIFONT
+{
+
+class FONT;
+class METRICS;
+
+/**
+ * Process-wide cache of stroke font text converted to segments and polygons.
+ *
+ * Reference designators and values share a handful of strings, sizes and fonts across a board,
+ * but DRC and plotting used to expand the glyphs and convert every stroke to a polygon again
+ * for each text item.  The cache stores the shapes of a text drawn at the origin without
+ * rotation; callers get copies moved and rotated to the actual text position.
+ *
+ * The cache may be used from several threads.
+ */
+class GAL_API STROKE_TEXT_CACHE
+{
+public:
+    static STROKE_TEXT_CACHE& GetInstance();
+
+    /**
+     * Return the strokes of \a aText drawn with the stroke font \a aFont at \a aPosition.
+     *
+     * @param aAttrs are the text attributes, including its rotation.
+     */
+    std::vector<SEG> GetStrokes( const FONT* aFont, const wxString& aText,
+                                 const VECTOR2I& aPosition, const TEXT_ATTRIBUTES& aAttrs,
+                                 const METRICS& aFontMetrics );
+
+    /**
+     * Append the (simplified) polygonal shape of \a aText drawn with the stroke font \a aFont
+     * at \a aPosition to \a aBuffer.  Strokes are converted to ovals of aAttrs.m_StrokeWidth.
+     */
+    void TransformTextToPolySet( SHAPE_POLY_SET& aBuffer, const FONT* aFont,
+                                 const wxString& aText, const VECTOR2I& aPosition,
+                                 const TEXT_ATTRIBUTES& aAttrs, const METRICS& aFontMetrics,
+                                 int aMaxError, ERROR_LOC aErrorLoc );
+
+    void Clear();
+
+private:
+    STROKE_TEXT_CACHE() = default;
+
+    struct KEY
+    {
+        const FONT*     m_font;
+        wxString        m_text;
+        TEXT_ATTRIBUTES m_attrs;           ///< Without rotation
+        double          m_interlinePitch;
+        double          m_overbarHeight;
+        double          m_underlineOffset;
+        int             m_maxError;        ///< Unused (-1) for strokes
+        ERROR_LOC       m_errorLoc;
+
+        bool operator==( const KEY& aRhs ) const;
+    };
+
+    struct KEY_HASH
+    {
+        std::size_t operator()( const KEY& aKey ) const;
+    };
+
+    static KEY makeKey( const FONT* aFont, const wxString& aText, const TEXT_ATTRIBUTES& aAttrs,
+                        const METRICS& aFontMetrics, int aMaxError, ERROR_LOC aErrorLoc );
+
+    std::shared_ptr<const std::vector<SEG>> getStrokes( const KEY& aKey,
+                                                        const METRICS& aFontMetrics );
+
+    std::mutex                                                                m_mutex;
+    std::unordered_map<KEY, std::shared_ptr<const std::vector<SEG>>, KEY_HASH> m_strokes;
+    std::unordered_map<KEY, std::shared_ptr<const SHAPE_POLY_SET>, KEY_HASH>   m_polys;
+};
+
+} // namespace KIFONT
+
+#endif // STROKE_TEXT_CACHE_H
@@ -39,6 +39,7 @@
 #include <render_settings.h>
 #include <layer_ids.h>
 #include <memory>
+#include <vector>
 
 namespace KIGFX
 {
@@ -96,6 +97,17 @@ public:
      */
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) = 0;
 
+    /**
+     * Called before a batch of items is redrawn into cached groups.
+     *
+     * Painters may use it to build, possibly in parallel, the geometry that Draw() would
+     * otherwise compute on the fly.  The GAL calls themselves are still issued sequentially
+     * by Draw(), so this must not touch the GAL.
+     *
+     * @param aItems are the items about to be redrawn.
+     */
+    virtual void PrepareItems( const std::vector<const VIEW_ITEM*>& aItems ) {}
+
 protected:
     /// Instance of graphic abstraction layer that gives an interface to call
     /// commands used to draw (eg. DrawLine, DrawCircle, etc.)
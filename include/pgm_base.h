@@ -429,6 +429,8 @@ protected:
 
     wxString        m_text_editor;
 
+    wxString        m_glyphCacheFile;         /// Where the outline font glyph cache is persisted
+
 #ifdef KICAD_USE_SENTRY
     wxFileName      m_sentry_optin_fn;
     wxFileName      m_sentry_uid_fn;
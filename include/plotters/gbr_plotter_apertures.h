@@ -26,6 +26,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 
 /* Class to handle a D_CODE when plotting a board using Standard Aperture Templates
  * (complex apertures need aperture macros to be flashed)
@@ -142,6 +145,45 @@ public:
 };
 
 
+/**
+ * Key used to find apertures (and free polygon aperture macros) in a hashed dictionary rather
+ * than by scanning the whole list.
+ *
+ * Corner lists are compared with a small tolerance to accept rounding issues coming from
+ * geometric transforms, so they cannot be hashed directly: they are keyed on their corner
+ * count and on the cell of a coarse grid holding their first corner, and lookups also probe
+ * the neighbouring cells.
+ */
+struct APERTURE_KEY
+{
+    int       m_Type = 0;
+    VECTOR2I  m_Size;
+    int       m_Radius = 0;
+    EDA_ANGLE m_Rotation;
+    int       m_ApertureAttribute = 0;
+    int       m_CornerCount = 0;
+    VECTOR2I  m_FirstCornerCell;
+
+    bool operator==( const APERTURE_KEY& aOther ) const
+    {
+        return m_Type == aOther.m_Type && m_Size == aOther.m_Size
+                && m_Radius == aOther.m_Radius && m_Rotation == aOther.m_Rotation
+                && m_ApertureAttribute == aOther.m_ApertureAttribute
+                && m_CornerCount == aOther.m_CornerCount
+                && m_FirstCornerCell == aOther.m_FirstCornerCell;
+    }
+};
+
+
+struct APERTURE_KEY_HASH
+{
+    std::size_t operator()( const APERTURE_KEY& aKey ) const;
+};
+
+
+typedef std::unordered_multimap<APERTURE_KEY, int, APERTURE_KEY_HASH> APERTURE_POLY_INDEX;
+
+
 /** A class to define an aperture macros based on a free polygon, i.e. using a
  * primitive 4 to describe a free polygon with a rotation.
  * the aperture macro has only one parameter: rotation and is defined on the fly
@@ -183,7 +225,11 @@ class APER_MACRO_FREEPOLY_LIST
 public:
     APER_MACRO_FREEPOLY_LIST() {}
 
-    void ClearList() { m_AMList.clear(); }
+    void ClearList()
+    {
+        m_AMList.clear();
+        m_index.clear();
+    }
 
     int AmCount() const { return (int)m_AMList.size(); }
 
@@ -208,4 +254,7 @@ public:
     void Format( FILE * aOutput, double aIu2GbrMacroUnit );
 
     std::vector<APER_MACRO_FREEPOLY> m_AMList;
+
+private:
+    APERTURE_POLY_INDEX m_index;     // m_AMList indices keyed by polygon
 };
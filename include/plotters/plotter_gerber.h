@@ -371,6 +371,11 @@ protected:
     void writeApertureList();
 
     std::vector<APERTURE> m_apertures;  // The list of available apertures
+
+    // m_apertures indices, for apertures defined by a size and for corner list apertures
+    std::unordered_map<APERTURE_KEY, int, APERTURE_KEY_HASH> m_apertureIndex;
+    APERTURE_POLY_INDEX                                       m_polyApertureIndex;
+
     int     m_currentApertureIdx;       // The index of the current aperture in m_apertures
     bool    m_hasApertureRoundRect;     // true is at least one round rect aperture is in use
     bool    m_hasApertureRotOval;       // true is at least one oval rotated aperture is in use
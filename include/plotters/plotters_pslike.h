@@ -27,6 +27,15 @@
 
 #include "plotter.h"
 
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+#include <richio.h>
+
+class wxMemoryOutputStream;
+class wxZlibOutputStream;
+
 
 /**
  * The PSLIKE_PLOTTER class is an intermediate class to handle common routines for engines
@@ -235,6 +244,38 @@ protected:
 };
 
 
+/**
+ * Collect the content of a PDF stream in memory.
+ *
+ * The data is deflated in chunks while it is written, so a page is never held uncompressed
+ * (neither in memory nor in a temporary file).  When \a aCompress is false the data is kept
+ * as it is, which is useful to debug the PDF writer.
+ */
+class PDF_STREAM_FORMATTER : public OUTPUTFORMATTER
+{
+public:
+    PDF_STREAM_FORMATTER( bool aCompress );
+    ~PDF_STREAM_FORMATTER();
+
+    /**
+     * Finish the stream and write it to \a aFile.
+     *
+     * @return the number of bytes written.
+     */
+    size_t WriteTo( FILE* aFile );
+
+protected:
+    void write( const char* aOutBuf, int aCount ) override;
+
+private:
+    void flushPending();
+
+    std::string                           m_pending;      ///< Data not compressed yet
+    std::unique_ptr<wxMemoryOutputStream> m_memStream;
+    std::unique_ptr<wxZlibOutputStream>   m_zlibStream;   ///< nullptr if not compressing
+};
+
+
 class PDF_PLOTTER : public PSLIKE_PLOTTER
 {
 public:
@@ -246,6 +287,7 @@ public:
             m_pageStreamHandle( 0 ),
             m_streamLengthHandle( 0 ),
             m_workFile( nullptr ),
+            m_capturingForm( false ),
             m_totalOutlineNodes( 0 )
     {
     }
@@ -341,6 +383,24 @@ public:
 
     virtual void PenTo( const VECTOR2I& pos, char plume ) override;
 
+    /**
+     * Filled pads with many vertices are emitted once as a form XObject, and each pad with the
+     * same shape only references it.
+     */
+    virtual void FlashPadRoundRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                    int aCornerRadius, const EDA_ANGLE& aOrient,
+                                    OUTLINE_MODE aTraceMode, void* aData ) override;
+    virtual void FlashPadCustom( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                 const EDA_ANGLE& aOrient, SHAPE_POLY_SET* aPolygons,
+                                 OUTLINE_MODE aTraceMode, void* aData ) override;
+    virtual void FlashPadTrapez( const VECTOR2I& aPadPos, const VECTOR2I* aCorners,
+                                 const EDA_ANGLE& aPadOrient, OUTLINE_MODE aTraceMode,
+                                 void* aData ) override;
+
+    /**
+     * The strokes of the text are emitted as a form XObject, shared by all texts with the same
+     * string, size, orientation and font.
+     */
     virtual void Text( const VECTOR2I&        aPos,
                        const COLOR4D&         aColor,
                        const wxString&        aText,
@@ -457,14 +517,39 @@ protected:
      * Pass -1 (default) for a fresh object. Especially from PDF 1.5 streams
      * can contain a lot of things, but for the moment we only handle page
      * content.
+     *
+     * @param aDictEntries are additional entries for the stream dictionary.
      */
-    int startPdfStream(int handle = -1);
+    int startPdfStream( int handle = -1, const char* aDictEntries = "" );
 
     /**
      * Finish the current PDF stream (writes the deferred length, too)
      */
     void closePdfStream();
 
+    /**
+     * Plot something as a reusable form XObject placed at \a aPos.
+     *
+     * \a aPlotFunc is called to plot the item at the plot origin; its output is captured and
+     * becomes the content of the form.  Items producing the same output share a single form.
+     * A form costs more than plotting an item once, so the first time some output is seen it
+     * is plotted inline and it only becomes a form when it repeats.
+     *
+     * Colors set by \a aPlotFunc are ignored, so the form is drawn with the color current where
+     * it is used; set it before calling this.  The graphics state is restored after the item,
+     * so the line width or dash pattern set in it do not apply to what comes next.
+     *
+     * @param aRadius is an upper bound of the item size around \a aPos, used for the form
+     *                bounding box.
+     */
+    void plotAsForm( const VECTOR2I& aPos, int aRadius,
+                     const std::function<void( const VECTOR2I& aOrigin )>& aPlotFunc );
+
+    /**
+     * Emit the form XObjects collected by plotAsForm().
+     */
+    void emitForms();
+
     /**
      * Starts emitting the outline object
      */
@@ -490,9 +575,12 @@ protected:
     std::vector<int> m_pageHandles; ///< Handles to the page objects
     int m_pageStreamHandle;         ///< Handle of the page content object
     int m_streamLengthHandle;       ///< Handle to the deferred stream length
-    wxString m_workFilename;
     wxString m_pageName;
-    FILE* m_workFile;               ///< Temporary file to construct the stream before zipping
+    OUTPUTFORMATTER* m_workFile;    ///< Destination of the content stream operators
+    bool m_capturingForm;           ///< plotAsForm() is capturing the content of a form
+
+    ///< Page content stream, compressed while it is being written
+    std::unique_ptr<PDF_STREAM_FORMATTER> m_pageStream;
     std::vector<long> m_xrefTable;  ///< The PDF xref offset table
 
     ///< List of user-space page numbers for resolving internal hyperlinks
@@ -510,6 +598,16 @@ protected:
 
     std::map<int, wxImage> m_imageHandles;
 
+    struct PDF_FORM
+    {
+        std::string m_content;      ///< Content stream of the form
+        BOX2D       m_bbox;         ///< Bounding box in device units
+    };
+
+    ///< Form handles by content, 0 for content seen only once so far
+    std::unordered_map<std::string, int> m_formHandles;
+    std::map<int, PDF_FORM>              m_forms;          ///< Forms to emit, by handle
+
     std::unique_ptr<OUTLINE_NODE> m_outlineRoot;    ///< Root outline node
     int                           m_totalOutlineNodes;  ///< Total number of outline nodes
 };
@@ -572,6 +670,27 @@ public:
 
     virtual void PenTo( const VECTOR2I& pos, char plume ) override;
 
+    /**
+     * Filled pads with many vertices can be emitted once as a \<symbol\> (with integer
+     * coordinates) and instantiated with \<use\>, see SetUseSymbols().
+     */
+    virtual void FlashPadRoundRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                    int aCornerRadius, const EDA_ANGLE& aOrient,
+                                    OUTLINE_MODE aTraceMode, void* aData ) override;
+    virtual void FlashPadCustom( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                 const EDA_ANGLE& aOrient, SHAPE_POLY_SET* aPolygons,
+                                 OUTLINE_MODE aTraceMode, void* aData ) override;
+    virtual void FlashPadTrapez( const VECTOR2I& aPadPos, const VECTOR2I* aCorners,
+                                 const EDA_ANGLE& aPadOrient, OUTLINE_MODE aTraceMode,
+                                 void* aData ) override;
+
+    /**
+     * Emit each unique filled pad shape only once as a \<symbol\>, and instantiate it with
+     * \<use\> for every pad.  This makes exports of dense boards a lot smaller.  Must be called
+     * before plotting.
+     */
+    void SetUseSymbols( bool aUseSymbols ) { m_useSymbols = aUseSymbols; }
+
     /**
      * Select SVG coordinate precision (number of digits needed for 1 mm  )
      * (SVG plotter uses always metric unit)
@@ -643,6 +762,11 @@ protected:
      */
     void setFillMode( FILL_T fill );
 
+    /**
+     * Plot \a aPolygons (given relative to \a aPos) filled, as a \<use\> of a symbol.
+     */
+    void flashPolygonsAsSymbol( const VECTOR2I& aPos, const SHAPE_POLY_SET& aPolygons );
+
     FILL_T     m_fillMode;          // true if the current contour rect, arc, circle, polygon must
                                     // be filled
     long       m_pen_rgb_color;     // current rgb color value: each color has a value 0 ... 255,
@@ -657,4 +781,9 @@ protected:
                                     // Use 3-6 (3 means um precision, 6 nm precision) in PcbNew
                                     // 3-4 in other modules (avoid values >4 to avoid overflow)
                                     // see also comment for m_useInch.
+
+    bool       m_useSymbols;        // emit repeated pad shapes as <symbol> and <use>
+
+    std::unordered_map<std::string, int> m_symbolIds;   // symbol ids by symbol paths
+    std::vector<std::string>             m_symbols;     // symbol paths by symbol id
 };
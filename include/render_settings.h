@@ -213,6 +213,13 @@ public:
     int GetMinPenWidth() const { return m_minPenWidth; }
     void SetMinPenWidth( int aWidth ) { m_minPenWidth = aWidth; }
 
+    /**
+     * Maximum deviation (in internal units) painters may introduce when simplifying geometry
+     * drawn on level of detail layers (see VIEW::SetLayerLOD()).  0 requests full detail.
+     */
+    int GetLODTolerance() const { return m_lodTolerance; }
+    void SetLODTolerance( int aTolerance ) { m_lodTolerance = aTolerance; }
+
     double GetDashLengthRatio() const { return m_dashLengthRatio; }
     void SetDashLengthRatio( double aRatio ) { m_dashLengthRatio = aRatio; }
     double GetDashLength( int aLineWidth ) const;
@@ -348,6 +355,8 @@ protected:
     double        m_dashLengthRatio;
     double        m_gapLengthRatio;
 
+    int           m_lodTolerance;         // Geometry simplification allowed at the current zoom
+
     wxString      m_defaultFont;
 
     bool          m_isPrinting;           // true when draw to a printer
@@ -459,6 +459,30 @@ public:
         }
     }
 
+    /**
+     * Mark a layer as level of detail layer: its items are repainted whenever the zoom level
+     * crosses into another LOD band, so painters may draw them with coarser geometry when zoomed
+     * out (see RENDER_SETTINGS::GetLODTolerance()).
+     */
+    inline void SetLayerLOD( int aLayer, bool aLOD = true )
+    {
+        wxCHECK( aLayer < (int) m_layers.size(), /*void*/ );
+        m_layers[aLayer].lod = aLOD;
+    }
+
+    /**
+     * Set the world size of a screen pixel from which level of detail layers are drawn with
+     * simplified geometry.  Each following band covers a four times larger pixel size.
+     *
+     * @param aPixelSize is the pixel size in world units, or 0 to always draw full detail.
+     */
+    void SetLODThreshold( double aPixelSize );
+
+    /**
+     * @return the current level of detail band; 0 means full detail.
+     */
+    int GetLODBand() const { return m_lodBand; }
+
     /**
      * Set a layer display-only (ie: to be rendered but not returned by hit test queries).
      */
@@ -744,6 +768,7 @@ protected:
         bool                    displayOnly;     ///< Is the layer display only?
         bool                    diffLayer;       ///< Layer should be drawn differentially over lower layers
         bool                    hasNegatives;    ///< Layer should be drawn separately to not delete lower layers
+        bool                    lod;             ///< Layer is repainted when the LOD band changes
         std::shared_ptr<VIEW_RTREE> items;       ///< R-tree indexing all items on this layer.
         int                     renderingOrder;  ///< Rendering order of this layer.
         int                     id;              ///< Layer ID.
@@ -823,6 +848,12 @@ protected:
     ///< Update set of layers that an item occupies
     void updateLayers( VIEW_ITEM* aItem );
 
+    ///< Rebuild the R-trees of all layers from scratch, refreshing every item's bbox and layers
+    void rebuildAllLayers();
+
+    ///< Recompute the LOD band for the current scale and repaint LOD layers if it changed
+    void updateLOD();
+
     ///< Determine rendering order of layers. Used in display order sorting function.
     static bool compareRenderingOrder( VIEW_LAYER* aI, VIEW_LAYER* aJ )
     {
@@ -854,6 +885,9 @@ protected:
     ///< Flat list of all items.
     std::shared_ptr<std::vector<VIEW_ITEM*>> m_allItems;
 
+    ///< Items queued by Update() since the last UpdateItems() call (removed ones are nullptr).
+    std::vector<VIEW_ITEM*>            m_dirtyItems;
+
     ///< The set of layers that are displayed on the top.
     std::set<unsigned int>             m_topLayers;
 
@@ -889,6 +923,12 @@ protected:
 
     ///< Flag to reverse the draw order when using draw priority.
     bool m_reverseDrawOrder;
+
+    ///< Pixel size (in world units) from which LOD layers are simplified; 0 disables LOD.
+    double m_lodThreshold;
+
+    ///< Current level of detail band.
+    int m_lodBand;
 };
 } // namespace KIGFX
 
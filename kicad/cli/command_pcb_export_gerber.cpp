@@ -82,6 +82,11 @@ CLI::PCB_EXPORT_GERBER_COMMAND::PCB_EXPORT_GERBER_COMMAND( const std::string& aN
     m_argParser.add_argument( ARG_NO_PROTEL_EXTENSION )
             .help( UTF8STDSTR( _( "Use KiCad Gerber file extension" ) ) )
             .flag();
+
+    m_argParser.add_argument( ARG_MERGE_COPPER )
+            .help( UTF8STDSTR( _( "Plot the tracks and zones of each net on copper layers as "
+                                  "merged regions" ) ) )
+            .flag();
 }
 
 
@@ -107,6 +112,7 @@ int CLI::PCB_EXPORT_GERBER_COMMAND::populateJob( JOB_EXPORT_PCB_GERBER* aJob )
     aJob->m_useAuxOrigin = m_argParser.get<bool>( ARG_USE_DRILL_FILE_ORIGIN );
     aJob->m_useProtelFileExtension = !m_argParser.get<bool>( ARG_NO_PROTEL_EXTENSION );
     aJob->m_precision = m_argParser.get<int>( ARG_PRECISION );
+    aJob->m_mergeCopper = m_argParser.get<bool>( ARG_MERGE_COPPER );
     aJob->m_printMaskLayer = m_selectedLayers;
 
     if( !wxFile::Exists( aJob->m_filename ) )
@@ -34,6 +34,7 @@ namespace CLI
 #define ARG_USE_DRILL_FILE_ORIGIN "--use-drill-file-origin"
 #define ARG_PRECISION "--precision"
 #define ARG_NO_PROTEL_EXTENSION "--no-protel-ext"
+#define ARG_MERGE_COPPER "--merge-copper"
 
 class PCB_EXPORT_GERBER_COMMAND : public PCB_EXPORT_BASE_COMMAND
 {
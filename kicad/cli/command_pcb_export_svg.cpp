@@ -32,6 +32,7 @@
 
 #define ARG_EXCLUDE_DRAWING_SHEET "--exclude-drawing-sheet"
 #define ARG_PAGE_SIZE "--page-size-mode"
+#define ARG_USE_SYMBOLS "--use-symbols"
 
 
 CLI::PCB_EXPORT_SVG_COMMAND::PCB_EXPORT_SVG_COMMAND() : PCB_EXPORT_BASE_COMMAND( "svg" )
@@ -79,6 +80,11 @@ CLI::PCB_EXPORT_SVG_COMMAND::PCB_EXPORT_SVG_COMMAND() : PCB_EXPORT_BASE_COMMAND(
             .scan<'i', int>()
             .default_value( 2 )
             .metavar( "SHAPE_OPTION" );
+
+    m_argParser.add_argument( ARG_USE_SYMBOLS )
+            .help( UTF8STDSTR( _( "Write each unique pad shape once and reference it, which "
+                                  "makes the files of dense boards much smaller" ) ) )
+            .flag();
 }
 
 
@@ -96,6 +102,7 @@ int CLI::PCB_EXPORT_SVG_COMMAND::doPerform( KIWAY& aKiway )
     svgJob->m_negative = m_argParser.get<bool>( ARG_NEGATIVE );
     svgJob->m_sketchPadsOnFabLayers = m_argParser.get<bool>( ARG_SKETCH_PADS_ON_FAB_LAYERS );
     svgJob->m_drillShapeOption = m_argParser.get<int>( ARG_DRILL_SHAPE_OPTION );
+    svgJob->m_useSymbols = m_argParser.get<bool>( ARG_USE_SYMBOLS );
     svgJob->m_drawingSheet = m_argDrawingSheet;
 
     svgJob->m_filename = m_argInput;
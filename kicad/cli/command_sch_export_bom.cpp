@@ -47,6 +47,16 @@ CLI::SCH_EXPORT_BOM_COMMAND::SCH_EXPORT_BOM_COMMAND() : COMMAND( "bom" )
             .default_value( std::string( "" ) )
             .metavar( "FMT_PRESET" );
 
+    m_argParser.add_argument( ARG_PRESETS )
+            .help( UTF8STDSTR( _( ARG_PRESETS_DESC ) ) )
+            .default_value( std::string( "" ) )
+            .metavar( "PRESETS" );
+
+    m_argParser.add_argument( ARG_FMT_PRESETS )
+            .help( UTF8STDSTR( _( ARG_FMT_PRESETS_DESC ) ) )
+            .default_value( std::string( "" ) )
+            .metavar( "FMT_PRESETS" );
+
     // Field output options
     m_argParser.add_argument( ARG_FIELDS )
             .help( UTF8STDSTR( _( ARG_FIELDS_DESC ) ) )
@@ -140,6 +150,11 @@ int CLI::SCH_EXPORT_BOM_COMMAND::doPerform( KIWAY& aKiway )
     bomJob->m_bomFmtPresetName =
             From_UTF8( m_argParser.get<std::string>( ARG_FMT_PRESET ).c_str() );
 
+    bomJob->m_bomPresetNames =
+            convertStringList( From_UTF8( m_argParser.get<std::string>( ARG_PRESETS ).c_str() ) );
+    bomJob->m_bomFmtPresetNames = convertStringList(
+            From_UTF8( m_argParser.get<std::string>( ARG_FMT_PRESETS ).c_str() ) );
+
     // Format options
     bomJob->m_fieldDelimiter =
             From_UTF8( m_argParser.get<std::string>( ARG_FIELD_DELIMITER ).c_str() );
@@ -33,6 +33,15 @@ namespace CLI
 #define ARG_FMT_PRESET "--format-preset"
 #define ARG_FMT_PRESET_DESC "Use a named BOM format preset setting from the schematic, e.g. CSV."
 
+// Options for exporting several presets from a single load of the schematic
+#define ARG_PRESETS "--presets"
+#define ARG_PRESETS_DESC "A list of named BOM presets to export in one pass. Each preset is " \
+                         "written to its own file named after the output file and the preset."
+
+#define ARG_FMT_PRESETS "--format-presets"
+#define ARG_FMT_PRESETS_DESC "A list of named BOM format presets to export in one pass. Each " \
+                             "preset is combined with every BOM preset."
+
 // Options for setting the format of the export, e.g. CSV
 #define ARG_FIELD_DELIMITER "--field-delimiter"
 #define ARG_FIELD_DELIMITER_DESC "Separator between output fields/columns."
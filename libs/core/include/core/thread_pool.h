@@ -25,6 +25,13 @@
 #ifndef INCLUDE_THREAD_POOL_H_
 #define INCLUDE_THREAD_POOL_H_
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
 #include <bs_thread_pool.hpp>
 
 using thread_pool = BS::thread_pool;
@@ -39,4 +46,80 @@ using thread_pool = BS::thread_pool;
 thread_pool& GetKiCadThreadPool();
 
 
+/**
+ * Call \a aFunc for every index in [0, aCount) using the KiCad thread pool.
+ *
+ * The calling thread takes part in the work and only waits for indices that have already
+ * been claimed by a worker, so this can safely be called from a task that is itself running
+ * on the pool (e.g. the per-zone triangulation in BOARD::CacheTriangulation()).
+ *
+ * If \a aFunc throws, the indices not started yet are skipped and the first exception is
+ * rethrown to the caller once all the running calls are finished.
+ */
+template <typename Func>
+void ParallelForEach( size_t aCount, Func&& aFunc )
+{
+    if( aCount == 0 )
+        return;
+
+    struct WORK_STATE
+    {
+        std::atomic<size_t>     next = 0;
+        std::atomic<bool>       failed = false;
+        size_t                  done = 0;
+        std::exception_ptr      exception;
+        std::mutex              mutex;
+        std::condition_variable cv;
+    };
+
+    // Tasks which are dequeued after all the work is finished only touch the shared state,
+    // so it must outlive this call.
+    std::shared_ptr<WORK_STATE> state = std::make_shared<WORK_STATE>();
+
+    auto worker =
+            [state, aCount, &aFunc]()
+            {
+                for( size_t ii = state->next++; ii < aCount; ii = state->next++ )
+                {
+                    std::exception_ptr exception;
+
+                    if( !state->failed )
+                    {
+                        try
+                        {
+                            aFunc( ii );
+                        }
+                        catch( ... )
+                        {
+                            exception = std::current_exception();
+                            state->failed = true;
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lock( state->mutex );
+
+                    if( exception && !state->exception )
+                        state->exception = exception;
+
+                    if( ++state->done == aCount )
+                        state->cv.notify_all();
+                }
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       helpers = std::min<size_t>( aCount, tp.get_thread_count() ) - 1;
+
+    for( size_t ii = 0; ii < helpers; ++ii )
+        tp.push_task( worker );
+
+    worker();
+
+    std::unique_lock<std::mutex> lock( state->mutex );
+    state->cv.wait( lock, [&]() { return state->done == aCount; } );
+
+    if( state->exception )
+        std::rethrow_exception( state->exception );
+}
+
+
 #endif /* INCLUDE_THREAD_POOL_H_ */
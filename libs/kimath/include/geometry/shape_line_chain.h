@@ -85,6 +85,11 @@ public:
     typedef std::vector<VECTOR2I>::iterator point_iter;
     typedef std::vector<VECTOR2I>::const_iterator point_citer;
 
+    /// Index of an arc in the chain, or SHAPE_IS_PT.  Only 32 bits are used as a pair of these
+    /// is stored for every vertex, which adds up quickly for large zone fills.
+    typedef int32_t shape_idx;
+    typedef std::pair<shape_idx, shape_idx> shape_idx_pair;
+
     /**
      * Represent an intersection between two line segments
      */
@@ -434,7 +439,7 @@ public:
     /**
      * @return the vector of values indicating shape type and location.
      */
-    const std::vector<std::pair<ssize_t, ssize_t>>& CShapes() const
+    const std::vector<shape_idx_pair>& CShapes() const
     {
         return m_shapes;
     }
@@ -945,7 +950,7 @@ private:
 
     static const ssize_t SHAPE_IS_PT;
 
-    static const std::pair<ssize_t, ssize_t> SHAPES_ARE_PT;
+    static const shape_idx_pair SHAPES_ARE_PT;
 
     /// array of vertices
     std::vector<VECTOR2I> m_points;
@@ -964,7 +969,7 @@ private:
      *
      * The second element must always be SHAPE_IS_PT if the first element is SHAPE_IS_PT.
      */
-    std::vector<std::pair<ssize_t, ssize_t>> m_shapes;
+    std::vector<shape_idx_pair> m_shapes;
 
     std::vector<SHAPE_ARC> m_arcs;
 
@@ -1118,6 +1118,17 @@ public:
      */
     void SimplifyOutlines( int aMaxError = 0 );
 
+    /**
+     * Reduce the polyset for display at a coarse level of detail.  Outlines and holes smaller
+     * than \a aTolerance in both directions are dropped, and the remaining lines are simplified
+     * with \a aTolerance as maximum error.
+     *
+     * The result is only meant to be drawn; it may no longer be a faithful copy of the input.
+     *
+     * @param aTolerance is the size below which features are considered invisible.
+     */
+    void Decimate( int aTolerance );
+
     /**
      * Convert a self-intersecting polygon to one (or more) non self-intersecting polygon(s).
      *
@@ -45,7 +45,7 @@
 class SHAPE;
 
 const ssize_t                     SHAPE_LINE_CHAIN::SHAPE_IS_PT = -1;
-const std::pair<ssize_t, ssize_t> SHAPE_LINE_CHAIN::SHAPES_ARE_PT = { SHAPE_IS_PT, SHAPE_IS_PT };
+const SHAPE_LINE_CHAIN::shape_idx_pair SHAPE_LINE_CHAIN::SHAPES_ARE_PT = { SHAPE_IS_PT, SHAPE_IS_PT };
 
 
 SHAPE_LINE_CHAIN::SHAPE_LINE_CHAIN( const std::vector<int>& aV)
@@ -64,7 +64,7 @@ SHAPE_LINE_CHAIN::SHAPE_LINE_CHAIN( const std::vector<VECTOR2I>& aV, bool aClose
         m_width( 0 )
 {
     m_points = aV;
-    m_shapes = std::vector<std::pair<ssize_t, ssize_t>>( aV.size(), SHAPES_ARE_PT );
+    m_shapes = std::vector<shape_idx_pair>( aV.size(), SHAPES_ARE_PT );
     SetClosed( aClosed );
 }
 
@@ -302,7 +302,7 @@ void SHAPE_LINE_CHAIN::convertArc( ssize_t aArcIndex )
     for( auto& sh : m_shapes )
     {
         alg::run_on_pair( sh,
-            [&]( ssize_t& aShapeIndex )
+            [&]( shape_idx& aShapeIndex )
             {
                 if( aShapeIndex == aArcIndex )
                     aShapeIndex = SHAPE_IS_PT;
@@ -408,7 +408,7 @@ void SHAPE_LINE_CHAIN::splitArc( ssize_t aPtIndex, bool aCoincident )
         // Only change the arc indices for the second half of the point range
         for( int i = aPtIndex; i < PointCount(); i++ )
         {
-            alg::run_on_pair( m_shapes[i], [&]( ssize_t& aIndex ) {
+            alg::run_on_pair( m_shapes[i], [&]( shape_idx& aIndex ) {
                 if( aIndex != SHAPE_IS_PT )
                     aIndex++;
             } );
@@ -967,7 +967,7 @@ const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Reverse() const
         if( sh != SHAPES_ARE_PT )
         {
             alg::run_on_pair( sh,
-                [&]( ssize_t& aShapeIndex )
+                [&]( shape_idx& aShapeIndex )
                 {
                     if( aShapeIndex != SHAPE_IS_PT )
                         aShapeIndex = a.m_arcs.size() - aShapeIndex - 1;
@@ -1101,12 +1101,12 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const SHAPE_LINE
 
     // The total new arcs index is added to the new arc indices
     size_t prev_arc_count = m_arcs.size();
-    std::vector<std::pair<ssize_t, ssize_t>> new_shapes = newLine.m_shapes;
+    std::vector<shape_idx_pair> new_shapes = newLine.m_shapes;
 
-    for( std::pair<ssize_t, ssize_t>& shape_pair : new_shapes )
+    for( shape_idx_pair& shape_pair : new_shapes )
     {
         alg::run_on_pair( shape_pair,
-            [&]( ssize_t& aShape )
+            [&]( shape_idx& aShape )
             {
                 if( aShape != SHAPE_IS_PT )
                     aShape += prev_arc_count;
@@ -1164,7 +1164,7 @@ void SHAPE_LINE_CHAIN::Remove( int aStartIndex, int aEndIndex )
     }
 
     std::set<size_t> extra_arcs;
-    auto logArcIdxRemoval = [&]( ssize_t& aShapeIndex )
+    auto logArcIdxRemoval = [&]( shape_idx& aShapeIndex )
                             {
                                 if( aShapeIndex != SHAPE_IS_PT )
                                     extra_arcs.insert( aShapeIndex );
@@ -1415,7 +1415,7 @@ void SHAPE_LINE_CHAIN::SetPoint( int aIndex, const VECTOR2I& aPos )
     m_points[aIndex] = aPos;
 
     alg::run_on_pair( m_shapes[aIndex],
-        [&]( ssize_t& aIdx )
+        [&]( shape_idx& aIdx )
         {
             if( aIdx != SHAPE_IS_PT )
                 convertArc( aIdx );
@@ -1597,11 +1597,11 @@ void SHAPE_LINE_CHAIN::Append( const SHAPE_LINE_CHAIN& aOtherLine )
     m_arcs.insert( m_arcs.end(), aOtherLine.m_arcs.begin(), aOtherLine.m_arcs.end() );
 
     auto fixShapeIndices =
-            [&]( const std::pair<ssize_t, ssize_t>& aShapeIndices ) -> std::pair<ssize_t, ssize_t>
+            [&]( const shape_idx_pair& aShapeIndices ) -> shape_idx_pair
             {
-                std::pair<ssize_t, ssize_t> retval =  aShapeIndices;
+                shape_idx_pair retval =  aShapeIndices;
 
-                alg::run_on_pair( retval, [&]( ssize_t& aIndex )
+                alg::run_on_pair( retval, [&]( shape_idx& aIndex )
                                           {
                                               if( aIndex != SHAPE_IS_PT )
                                                   aIndex = aIndex + num_arcs;
@@ -1721,7 +1721,7 @@ void SHAPE_LINE_CHAIN::Insert( size_t aVertex, const SHAPE_ARC& aArc )
     for( auto& sh : m_shapes )
     {
         alg::run_on_pair( sh,
-            [&]( ssize_t& aIndex )
+            [&]( shape_idx& aIndex )
             {
                 if( aIndex >= arc_pos )
                     aIndex++;
@@ -1739,7 +1739,7 @@ void SHAPE_LINE_CHAIN::Insert( size_t aVertex, const SHAPE_ARC& aArc )
 
     /// Step 3: Add the vector of indices to the shape vector
     //@todo need to check we aren't creating duplicate points at start or end
-    std::vector<std::pair<ssize_t, ssize_t>> new_points( chain.PointCount(),
+    std::vector<shape_idx_pair> new_points( chain.PointCount(),
                                                          { arc_pos, SHAPE_IS_PT } );
 
     m_shapes.insert( m_shapes.begin() + aVertex, new_points.begin(), new_points.end() );
@@ -2532,7 +2532,7 @@ double SHAPE_LINE_CHAIN::Area( bool aAbsolute ) const
 void SHAPE_LINE_CHAIN::RemoveDuplicatePoints()
 {
     std::vector<VECTOR2I> pts_unique;
-    std::vector<std::pair<ssize_t, ssize_t>> shapes_unique;
+    std::vector<shape_idx_pair> shapes_unique;
 
     // Always try to keep at least 2 points otherwise, we're not really a line
     if( PointCount() < 3 )
@@ -2563,7 +2563,7 @@ void SHAPE_LINE_CHAIN::RemoveDuplicatePoints()
             j++;
         }
 
-        std::pair<ssize_t,ssize_t> shapeToKeep = m_shapes[i];
+        shape_idx_pair shapeToKeep = m_shapes[i];
 
         if( shapeToKeep == SHAPES_ARE_PT )
             shapeToKeep = m_shapes[j - 1];
@@ -2597,7 +2597,7 @@ void SHAPE_LINE_CHAIN::Simplify( int aMaxError )
         return;
 
     std::vector<VECTOR2I> new_points;
-    std::vector<std::pair<ssize_t, ssize_t>> new_shapes;
+    std::vector<shape_idx_pair> new_shapes;
 
     new_points.reserve( m_points.size() );
     new_shapes.reserve( m_shapes.size() );
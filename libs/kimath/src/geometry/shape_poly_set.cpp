@@ -60,6 +60,7 @@
 
 // Do not keep this for release.  Only for testing clipper
 #include <advanced_config.h>
+#include <core/thread_pool.h>
 
 #include <wx/log.h>
 
@@ -2125,6 +2126,38 @@ void SHAPE_POLY_SET::SimplifyOutlines( int aMaxError )
 }
 
 
+void SHAPE_POLY_SET::Decimate( int aTolerance )
+{
+    for( int ii = (int) m_polys.size() - 1; ii >= 0; --ii )
+    {
+        POLYGON& paths = m_polys[ii];
+
+        // Walk backwards so that holes are handled before their outline
+        for( int jj = (int) paths.size() - 1; jj >= 0; --jj )
+        {
+            SHAPE_LINE_CHAIN& path = paths[jj];
+            const BOX2I       bbox = path.BBox();
+
+            if( bbox.GetWidth() >= aTolerance || bbox.GetHeight() >= aTolerance )
+            {
+                path.Simplify( aTolerance );
+
+                if( path.PointCount() >= 3 )
+                    continue;
+            }
+
+            if( jj == 0 )
+            {
+                m_polys.erase( m_polys.begin() + ii );
+                break;
+            }
+
+            paths.erase( paths.begin() + jj );
+        }
+    }
+}
+
+
 int SHAPE_POLY_SET::NormalizeAreaOutlines()
 {
     // We are expecting only one main outline, but this main outline can have holes
@@ -3323,26 +3356,53 @@ void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
 
     if( aPartition )
     {
-        for( int ii = 0; ii < OutlineCount(); ++ii )
-        {
-            // This partitions into regularly-sized grids (1cm in Pcbnew)
-            SHAPE_POLY_SET flattened( Outline( ii ) );
+        // Each outline is flattened, partitioned and triangulated independently, so the
+        // outlines are dispatched to the thread pool.  Results are gathered per outline and
+        // concatenated afterwards to keep the output order identical to a serial run.
+        std::vector<std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>> results( OutlineCount() );
+        std::vector<char> succeeded( OutlineCount(), 0 );
+
+        auto triangulateOutline =
+                [&]( size_t aIndex )
+                {
+                    int ii = static_cast<int>( aIndex );
 
-            for( int jj = 0; jj < HoleCount( ii ); ++jj )
-                flattened.AddHole( Hole( ii, jj ) );
+                    // This partitions into regularly-sized grids (1cm in Pcbnew)
+                    SHAPE_POLY_SET flattened( COutline( ii ) );
 
-            flattened.ClearArcs();
+                    for( int jj = 0; jj < HoleCount( ii ); ++jj )
+                        flattened.AddHole( CHole( ii, jj ) );
 
-            if( flattened.HasHoles() || flattened.IsSelfIntersecting() )
-                flattened.Fracture( PM_FAST );
-            else if( aSimplify )
-                flattened.Simplify( PM_FAST );
+                    flattened.ClearArcs();
+
+                    if( flattened.HasHoles() || flattened.IsSelfIntersecting() )
+                        flattened.Fracture( PM_FAST );
+                    else if( aSimplify )
+                        flattened.Simplify( PM_FAST );
+
+                    SHAPE_POLY_SET partitions = partitionPolyIntoRegularCellGrid( flattened, 1e7 );
+
+                    // This pushes the triangulation for all polys in partitions
+                    // to be referenced to the ii-th polygon
+                    succeeded[ii] = triangulate( partitions, ii, results[ii], aHintData );
+                };
+
+        if( OutlineCount() > 1 )
+            ParallelForEach( OutlineCount(), triangulateOutline );
+        else if( OutlineCount() == 1 )
+            triangulateOutline( 0 );
+
+        for( int ii = 0; ii < OutlineCount(); ++ii )
+        {
+            // A failed triangulation can leave an empty set behind; the serial version
+            // dropped it when the next outline started, so do the same here.
+            if( !m_triangulatedPolys.empty() && m_triangulatedPolys.back()->GetTriangleCount() == 0 )
+                m_triangulatedPolys.pop_back();
 
-            SHAPE_POLY_SET partitions = partitionPolyIntoRegularCellGrid( flattened, 1e7 );
+            for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : results[ii] )
+                m_triangulatedPolys.push_back( std::move( tri ) );
 
-            // This pushes the triangulation for all polys in partitions
-            // to be referenced to the ii-th polygon
-            if( !triangulate( partitions, ii , m_triangulatedPolys, aHintData ) )
+            if( !succeeded[ii] )
             {
                 wxLogTrace( TRIANGULATE_TRACE, "Failed to triangulate partitioned polygon %d", ii );
             }
@@ -333,6 +333,7 @@ void DIALOG_EXPORT_SVG::ExportSVGFile( bool aOnlyOneFile )
     svgPlotOptions.m_mirror = m_printMirror;
     svgPlotOptions.m_plotFrame = svgPlotOptions.m_pageSizeMode == 0;
     svgPlotOptions.m_drillShapeOption = 2;  // actual size hole.
+    svgPlotOptions.m_useSymbols = false;
 
     for( PCB_LAYER_ID layer : all_selected.Seq() )
     {
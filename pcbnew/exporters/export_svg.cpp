@@ -112,6 +112,7 @@ bool EXPORT_SVG::Plot( BOARD* aBoard, const PCB_PLOT_SVG_OPTIONS& aSvgPlotOption
     if( plotter )
     {
         plotter->SetColorMode( !aSvgPlotOptions.m_blackAndWhite );
+        plotter->SetUseSymbols( aSvgPlotOptions.m_useSymbols );
         PlotBoardLayers( aBoard, plotter, aSvgPlotOptions.m_printMaskLayer, plot_opts );
         plotter->EndPlot();
     }
@@ -40,6 +40,9 @@ struct PCB_PLOT_SVG_OPTIONS
     // 0 = no hole, 1 = small shape, 2 = actual shape
     // Not used in some plotters (Gerber)
     int m_drillShapeOption;
+
+    // Emit repeated pad shapes once as <symbol> and instantiate them with <use>
+    bool m_useSymbols = false;
 };
 
 class EXPORT_SVG
@@ -31,6 +31,7 @@
 #include <connectivity/connectivity_data.h>
 
 #include <board.h>
+#include <board_design_settings.h>
 #include <footprint.h>
 #include <pcb_track.h>
 #include <macros.h>
@@ -55,6 +56,9 @@
 
 using namespace std::placeholders;
 
+/// Pixel size, as a multiple of the board max error, from which LOD layers are simplified
+static const double LOD_THRESHOLD_FACTOR = 4.0;
+
 
 const int GAL_LAYER_ORDER[] =
 {
@@ -268,6 +272,9 @@ void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard, PROGRESS_REPORTER* aReport
 
     aBoard->CacheTriangulation( aReporter );
 
+    // Start simplifying LOD layers once a pixel covers several times the board's max error
+    m_view->SetLODThreshold( LOD_THRESHOLD_FACTOR * aBoard->GetDesignSettings().m_MaxError );
+
     if( m_drawingSheet )
         m_drawingSheet->SetFileName( TO_UTF8( aBoard->GetFileName() ) );
 
@@ -672,8 +679,20 @@ void PCB_DRAW_PANEL_GAL::setDefaultLayerDeps()
         {
             m_view->SetLayerDisplayOnly( layer );
         }
+
+        // Tracks, pads and zone fills are drawn with coarser geometry when zoomed out (keep in
+        // sync with PCB_PAINTER::isLODLayer())
+        if( IsCopperLayer( layer ) )
+        {
+            m_view->SetLayerLOD( layer );
+            m_view->SetLayerLOD( ZONE_LAYER_FOR( layer ) );
+        }
     }
 
+    m_view->SetLayerLOD( LAYER_PADS_TH );
+    m_view->SetLayerLOD( LAYER_PADS_SMD_FR );
+    m_view->SetLayerLOD( LAYER_PADS_SMD_BK );
+
     m_view->SetLayerTarget( LAYER_ANCHOR, KIGFX::TARGET_NONCACHED );
     m_view->SetLayerDisplayOnly( LAYER_ANCHOR );
 
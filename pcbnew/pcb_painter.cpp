@@ -68,6 +68,7 @@
 #include <kiface_base.h>
 #include <gr_text.h>
 #include <pgm_base.h>
+#include <core/thread_pool.h>
 
 using namespace KIGFX;
 
@@ -543,6 +544,93 @@ int PCB_PAINTER::getViaDrillSize( const PCB_VIA* aVia ) const
 }
 
 
+void PCB_PAINTER::PrepareItems( const std::vector<const VIEW_ITEM*>& aItems )
+{
+    // Below this count the thread pool overhead outweighs the gain
+    const size_t MIN_PARALLEL_ITEMS = 1000;
+
+    if( aItems.size() < MIN_PARALLEL_ITEMS )
+        return;
+
+    bool triangulate = m_gal->IsOpenGlEngine();
+    ZONE_DISPLAY_MODE zoneDisplayMode = m_pcbSettings.m_ZoneDisplayMode;
+
+    // Build the cached shapes the draw functions would otherwise build one item at a time.
+    // Pad shapes are built under the pad's own lock, and each polygon set belongs to a
+    // single item, so items can be prepared independently.
+    auto prepare =
+            [&]( const int a, const int b )
+            {
+                for( int ii = a; ii < b; ++ii )
+                {
+                    const BOARD_ITEM* item = dynamic_cast<const BOARD_ITEM*>( aItems[ii] );
+
+                    if( !item )
+                        continue;
+
+                    switch( item->Type() )
+                    {
+                    case PCB_PAD_T:
+                        static_cast<const PAD*>( item )->GetEffectiveShape();
+                        break;
+
+                    case PCB_ZONE_T:
+                    {
+                        const ZONE* zone = static_cast<const ZONE*>( item );
+
+                        // Build what draw() will use: the decimated fill when zoomed out,
+                        // or the triangulation of the full fill.
+                        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+                        {
+                            if( useZoneLOD( zoneDisplayMode, layer ) )
+                            {
+                                int maxError = getLODMaxError( ZONE_LAYER_FOR( layer ) );
+                                zone->GetLODFilledPolysList( layer, maxError, triangulate );
+                                continue;
+                            }
+
+                            if( !triangulate )
+                                continue;
+
+                            const std::shared_ptr<SHAPE_POLY_SET>& fill =
+                                    zone->GetFilledPolysList( layer );
+
+                            if( fill->OutlineCount() && !fill->IsTriangulationUpToDate() )
+                                fill->CacheTriangulation( true, true );
+                        }
+
+                        break;
+                    }
+
+                    case PCB_SHAPE_T:
+                    {
+                        const PCB_SHAPE* shape = static_cast<const PCB_SHAPE*>( item );
+
+                        if( !triangulate || shape->GetShape() != SHAPE_T::POLY || !shape->IsFilled() )
+                            break;
+
+                        SHAPE_POLY_SET& poly = const_cast<PCB_SHAPE*>( shape )->GetPolyShape();
+
+                        if( poly.OutlineCount() && !poly.IsTriangulationUpToDate() )
+                            poly.CacheTriangulation( true, true );
+
+                        break;
+                    }
+
+                    default:
+                        break;
+                    }
+                }
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    auto         returns = tp.parallelize_loop( 0, aItems.size(), prepare );
+
+    for( size_t ii = 0; ii < returns.size(); ++ii )
+        returns[ii].wait();
+}
+
+
 bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
 {
     const BOARD_ITEM* item = dynamic_cast<const BOARD_ITEM*>( aItem );
@@ -871,7 +959,8 @@ void PCB_PAINTER::draw( const PCB_ARC* aArc, int aLayer )
         if( aLayer == LAYER_LOCKED_ITEM_SHADOW )
             width = width + m_lockedShadowMargin;
 
-        m_gal->DrawArcSegment( center, radius, start_angle, angle, width, m_maxError );
+        m_gal->DrawArcSegment( center, radius, start_angle, angle, width,
+                               getLODMaxError( aLayer ) );
     }
 
     // Clearance lines
@@ -1659,8 +1748,8 @@ void PCB_PAINTER::draw( const PAD* aPad, int aLayer )
         {
             // This is expensive.  Avoid if possible.
             SHAPE_POLY_SET polySet;
-            aPad->TransformShapeToPolygon( polySet, ToLAYER_ID( aLayer ), margin.x, m_maxError,
-                                           ERROR_INSIDE );
+            aPad->TransformShapeToPolygon( polySet, ToLAYER_ID( aLayer ), margin.x,
+                                           getLODMaxError( aLayer ), ERROR_INSIDE );
             m_gal->DrawPolygon( polySet );
         }
     }
@@ -2709,7 +2798,18 @@ void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
                 || displayMode == ZONE_DISPLAY_MODE::SHOW_FRACTURE_BORDERS
                 || displayMode == ZONE_DISPLAY_MODE::SHOW_TRIANGULATION ) )
     {
-        const std::shared_ptr<SHAPE_POLY_SET>& polySet = aZone->GetFilledPolysList( layer );
+        std::shared_ptr<SHAPE_POLY_SET> polySet = aZone->GetFilledPolysList( layer );
+
+        // When zoomed out, draw a decimated copy of the fill: sub-pixel islands and details
+        // would only cost vertices without being visible.  The copy is cached by the zone,
+        // and usually already built by PrepareItems().
+        bool lod = useZoneLOD( displayMode, layer );
+
+        if( lod )
+        {
+            polySet = aZone->GetLODFilledPolysList( layer, getLODMaxError( aLayer ),
+                                                    m_gal->IsOpenGlEngine() );
+        }
 
         if( polySet->OutlineCount() == 0 )  // Nothing to draw
             return;
@@ -2733,7 +2833,7 @@ void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
         // as primitives. CacheTriangulation() can create basic triangle primitives to
         // draw the polygon solid shape on Opengl.  GLU tessellation is much slower,
         // so currently we are using our tessellation.
-        if( m_gal->IsOpenGlEngine() && !polySet->IsTriangulationUpToDate() )
+        if( !lod && m_gal->IsOpenGlEngine() && !polySet->IsTriangulationUpToDate() )
             polySet->CacheTriangulation( true, true );
 
         m_gal->DrawPolygon( *polySet, displayMode == ZONE_DISPLAY_MODE::SHOW_TRIANGULATION );
@@ -183,6 +183,9 @@ public:
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) override;
 
+    /// @copydoc PAINTER::PrepareItems()
+    virtual void PrepareItems( const std::vector<const VIEW_ITEM*>& aItems ) override;
+
 protected:
     PCB_VIEWERS_SETTINGS_BASE* viewer_settings();
 
@@ -226,6 +229,42 @@ protected:
      */
     virtual int getViaDrillSize( const PCB_VIA* aVia ) const;
 
+    /**
+     * Return true if \a aLayer is re-cached by the view when the level of detail changes, i.e.
+     * one of the layers registered with VIEW::SetLayerLOD() in PCB_DRAW_PANEL_GAL::SetupLayers().
+     */
+    static bool isLODLayer( int aLayer )
+    {
+        if( IsZoneFillLayer( aLayer ) )
+            return IsCopperLayer( aLayer - LAYER_ZONE_START );
+
+        return IsCopperLayer( aLayer ) || aLayer == LAYER_PADS_TH || aLayer == LAYER_PADS_SMD_FR
+               || aLayer == LAYER_PADS_SMD_BK;
+    }
+
+    /**
+     * Return the approximation error to use for geometry drawn on \a aLayer: the board max
+     * error or the zoom dependent LOD tolerance, whichever is larger, on level of detail layers
+     * and the board max error on all others, which are never redrawn on a zoom change.
+     */
+    int getLODMaxError( int aLayer ) const
+    {
+        if( !isLODLayer( aLayer ) )
+            return m_maxError;
+
+        return std::max( m_maxError, m_pcbSettings.GetLODTolerance() );
+    }
+
+    /**
+     * Return true if zone fills of \a aLayer are drawn decimated (see
+     * ZONE::GetLODFilledPolysList()) at the current zoom level with \a aDisplayMode.
+     */
+    bool useZoneLOD( ZONE_DISPLAY_MODE aDisplayMode, PCB_LAYER_ID aLayer ) const
+    {
+        return getLODMaxError( ZONE_LAYER_FOR( aLayer ) ) > m_maxError
+               && aDisplayMode == ZONE_DISPLAY_MODE::SHOW_FILLED;
+    }
+
     void strokeText( const wxString& aText, const VECTOR2I& aPosition,
                      const TEXT_ATTRIBUTES& aAttrs, const KIFONT::METRICS& aFontMetrics );
 
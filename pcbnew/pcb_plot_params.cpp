@@ -141,6 +141,7 @@ PCB_PLOT_PARAMS::PCB_PLOT_PARAMS()
     // This parameter controls if the NPTH pads will be plotted or not
     // it is a "local" parameter
     m_skipNPTH_Pads              = false;
+    m_gerberMergeCopper          = false;
 
     // line width to plot items in outline mode.
     m_sketchPadLineWidth         = pcbIUScale.mmToIU( 0.1 );
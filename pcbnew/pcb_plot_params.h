@@ -136,6 +136,9 @@ public:
     void        SetIncludeGerberNetlistInfo( bool aUse ) { m_includeGerberNetlistInfo = aUse; }
     bool        GetIncludeGerberNetlistInfo() const { return m_includeGerberNetlistInfo; }
 
+    void        SetGerberMergeCopper( bool aMerge ) { m_gerberMergeCopper = aMerge; }
+    bool        GetGerberMergeCopper() const { return m_gerberMergeCopper; }
+
     void        SetCreateGerberJobFile( bool aCreate ) { m_createGerberJobFile = aCreate; }
     bool        GetCreateGerberJobFile() const { return m_createGerberJobFile; }
 
@@ -243,6 +246,9 @@ private:
     /// Include netlist info (only in Gerber X2 format) (chapter ? in revision ?)
     bool       m_includeGerberNetlistInfo;
 
+    /// Plot the tracks and zones of each net on copper layers as merged regions (not saved)
+    bool       m_gerberMergeCopper;
+
     /// generate the auxiliary "job file" in gerber format
     bool       m_createGerberJobFile;
 
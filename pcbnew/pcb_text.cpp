@@ -39,6 +39,7 @@
 #include <string_utils.h>
 #include <geometry/shape_compound.h>
 #include <callback_gal.h>
+#include <font/stroke_text_cache.h>
 #include <convert_basic_shapes_to_polygon.h>
 #include <api/api_enums.h>
 #include <api/api_utils.h>
@@ -581,23 +582,37 @@ void PCB_TEXT::TransformTextToPolySet( SHAPE_POLY_SET& aBuffer, int aClearance,
     // Simplify shapes is not usually always efficient, but in this case it is.
     SHAPE_POLY_SET textShape;
 
-    CALLBACK_GAL callback_gal( empty_opts,
-            // Stroke callback
-            [&]( const VECTOR2I& aPt1, const VECTOR2I& aPt2 )
-            {
-                TransformOvalToPolygon( textShape, aPt1, aPt2, penWidth, aMaxError, aErrorLoc );
-            },
-            // Triangulation callback
-            [&]( const VECTOR2I& aPt1, const VECTOR2I& aPt2, const VECTOR2I& aPt3 )
-            {
-                textShape.NewOutline();
+    if( font->IsStroke() )
+    {
+        // Identical texts (reference designators and such) share their polygons
+        attrs.m_StrokeWidth = penWidth;
+        KIFONT::STROKE_TEXT_CACHE::GetInstance().TransformTextToPolySet( textShape, font,
+                                                                         GetShownText( true ),
+                                                                         GetTextPos(), attrs,
+                                                                         GetFontMetrics(),
+                                                                         aMaxError, aErrorLoc );
+    }
+    else
+    {
+        CALLBACK_GAL callback_gal( empty_opts,
+                // Stroke callback
+                [&]( const VECTOR2I& aPt1, const VECTOR2I& aPt2 )
+                {
+                    TransformOvalToPolygon( textShape, aPt1, aPt2, penWidth, aMaxError,
+                                            aErrorLoc );
+                },
+                // Triangulation callback
+                [&]( const VECTOR2I& aPt1, const VECTOR2I& aPt2, const VECTOR2I& aPt3 )
+                {
+                    textShape.NewOutline();
 
-                for( const VECTOR2I& point : { aPt1, aPt2, aPt3 } )
-                    textShape.Append( point.x, point.y );
-            } );
+                    for( const VECTOR2I& point : { aPt1, aPt2, aPt3 } )
+                        textShape.Append( point.x, point.y );
+                } );
 
-    font->Draw( &callback_gal, GetShownText( true ), GetTextPos(), attrs, GetFontMetrics() );
-    textShape.Simplify( SHAPE_POLY_SET::PM_FAST );
+        font->Draw( &callback_gal, GetShownText( true ), GetTextPos(), attrs, GetFontMetrics() );
+        textShape.Simplify( SHAPE_POLY_SET::PM_FAST );
+    }
 
     if( IsKnockout() )
     {
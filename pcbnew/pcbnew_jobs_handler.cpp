@@ -40,6 +40,8 @@
 #include <jobs/job_pcb_render.h>
 #include <jobs/job_pcb_drc.h>
 #include <lset.h>
+#include <locale_io.h>
+#include <core/thread_pool.h>
 #include <cli/exit_codes.h>
 #include <exporters/place_file_exporter.h>
 #include <exporters/step/exporter_step.h>
@@ -424,6 +426,7 @@ int PCBNEW_JOBS_HANDLER::JobExportSvg( JOB* aJob )
     svgPlotOptions.m_plotFrame = aSvgJob->m_plotDrawingSheet;
     svgPlotOptions.m_sketchPadsOnFabLayers = aSvgJob->m_sketchPadsOnFabLayers;
     svgPlotOptions.m_drillShapeOption = aSvgJob->m_drillShapeOption;
+    svgPlotOptions.m_useSymbols = aSvgJob->m_useSymbols;
 
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
@@ -654,9 +657,26 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
             aGerberJob->m_layersIncludeOnAll = plotOnAllLayersSelection;
     }
 
+    struct LAYER_PLOT
+    {
+        PCB_LAYER_ID    m_layer;
+        LSEQ            m_plotSequence;
+        PCB_PLOT_PARAMS m_plotOpts;
+        wxString        m_layerName;
+        wxString        m_sheetName;
+        wxString        m_sheetPath;
+        wxString        m_fullPath;
+        bool            m_plotted = false;
+    };
+
+    std::vector<LAYER_PLOT> layerPlots;
+
     for( PCB_LAYER_ID layer : LSET( aGerberJob->m_printMaskLayer ).UIOrder() )
     {
-        LSEQ plotSequence;
+        LAYER_PLOT& layerPlot = layerPlots.emplace_back();
+        LSEQ&       plotSequence = layerPlot.m_plotSequence;
+
+        layerPlot.m_layer = layer;
 
         // Base layer always gets plotted first.
         plotSequence.push_back( layer );
@@ -672,16 +692,19 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
         }
 
         // Pick the basename from the board file
-        wxFileName      fn( brd->GetFileName() );
-        wxString        layerName = brd->GetLayerName( layer );
-        wxString        sheetName;
-        wxString        sheetPath;
-        PCB_PLOT_PARAMS plotOpts;
+        wxFileName       fn( brd->GetFileName() );
+        wxString         layerName = brd->GetLayerName( layer );
+        PCB_PLOT_PARAMS& plotOpts = layerPlot.m_plotOpts;
 
         if( aGerberJob->m_useBoardPlotParams )
+        {
             plotOpts = boardPlotOptions;
+            plotOpts.SetGerberMergeCopper( aGerberJob->m_mergeCopper );
+        }
         else
+        {
             populateGerberPlotOptionsFromJob( plotOpts, aGerberJob );
+        }
 
         if( plotOpts.GetUseGerberProtelExtensions() )
             fileExt = GetGerberProtelExtension( layer );
@@ -697,32 +720,87 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
             layerName = aJob->GetVarOverrides().at( wxT( "LAYER" ) );
 
         if( aJob->GetVarOverrides().contains( wxT( "SHEETNAME" ) ) )
-            sheetName = aJob->GetVarOverrides().at( wxT( "SHEETNAME" ) );
+            layerPlot.m_sheetName = aJob->GetVarOverrides().at( wxT( "SHEETNAME" ) );
 
         if( aJob->GetVarOverrides().contains( wxT( "SHEETPATH" ) ) )
-            sheetPath = aJob->GetVarOverrides().at( wxT( "SHEETPATH" ) );
+            layerPlot.m_sheetPath = aJob->GetVarOverrides().at( wxT( "SHEETPATH" ) );
 
-        // We are feeding it one layer at the start here to silence a logic check
-        GERBER_PLOTTER* plotter = (GERBER_PLOTTER*) StartPlotBoard( brd, &plotOpts, layer,
-                                                                    layerName, fn.GetFullPath(),
-                                                                    sheetName, sheetPath );
+        layerPlot.m_layerName = layerName;
+        layerPlot.m_fullPath = fn.GetFullPath();
+    }
 
-        if( plotter )
-        {
-            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ), fn.GetFullPath() ),
-                                RPT_SEVERITY_ACTION );
-            PlotBoardLayers( brd, plotter, plotSequence, plotOpts );
-            plotter->EndPlot();
-        }
-        else
+    auto plotLayer =
+            [&]( LAYER_PLOT& aLayerPlot )
+            {
+                // We are feeding it one layer at the start here to silence a logic check
+                GERBER_PLOTTER* plotter = (GERBER_PLOTTER*) StartPlotBoard( brd,
+                                                                            &aLayerPlot.m_plotOpts,
+                                                                            aLayerPlot.m_layer,
+                                                                            aLayerPlot.m_layerName,
+                                                                            aLayerPlot.m_fullPath,
+                                                                            aLayerPlot.m_sheetName,
+                                                                            aLayerPlot.m_sheetPath );
+
+                if( plotter )
+                {
+                    PlotBoardLayers( brd, plotter, aLayerPlot.m_plotSequence,
+                                     aLayerPlot.m_plotOpts );
+                    plotter->EndPlot();
+                    aLayerPlot.m_plotted = true;
+                }
+
+                delete plotter;
+            };
+
+    auto reportLayer =
+            [&]( const LAYER_PLOT& aLayerPlot )
+            {
+                if( aLayerPlot.m_plotted )
+                {
+                    m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ),
+                                                          aLayerPlot.m_fullPath ),
+                                        RPT_SEVERITY_ACTION );
+                }
+                else
+                {
+                    m_reporter->Report( wxString::Format( _( "Failed to plot to '%s'.\n" ),
+                                                          aLayerPlot.m_fullPath ),
+                                        RPT_SEVERITY_ERROR );
+                    exitCode = CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+                }
+            };
+
+    if( aGerberJob->m_parallel && layerPlots.size() > 1 )
+    {
+        // Each layer gets its own plotter and file; the board is only read.  Build the cached
+        // item bounding boxes before the threads start so they are not computed concurrently,
+        // and keep the C locale for the whole export rather than toggling it per plotter.
+        LOCALE_IO dummy;
+
+        brd->ComputeBoundingBox( false, false );
+
+        thread_pool& tp = GetKiCadThreadPool();
+        auto         returns = tp.parallelize_loop( 0, layerPlots.size(),
+                [&]( const int a, const int b )
+                {
+                    for( int ii = a; ii < b; ++ii )
+                        plotLayer( layerPlots[ii] );
+                } );
+
+        for( size_t ii = 0; ii < returns.size(); ++ii )
+            returns[ii].wait();
+
+        // Report in the layer order, as the serial export does
+        for( const LAYER_PLOT& layerPlot : layerPlots )
+            reportLayer( layerPlot );
+    }
+    else
+    {
+        for( LAYER_PLOT& layerPlot : layerPlots )
         {
-            m_reporter->Report( wxString::Format( _( "Failed to plot to '%s'.\n" ),
-                                                  fn.GetFullPath() ),
-                                RPT_SEVERITY_ERROR );
-            exitCode = CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+            plotLayer( layerPlot );
+            reportLayer( layerPlot );
         }
-
-        delete plotter;
     }
 
     wxFileName fn( aGerberJob->m_filename );
@@ -756,6 +834,7 @@ void PCBNEW_JOBS_HANDLER::populateGerberPlotOptionsFromJob( PCB_PLOT_PARAMS& aPl
     aPlotOpts.SetUseAuxOrigin( aJob->m_useAuxOrigin );
     aPlotOpts.SetUseGerberProtelExtensions( aJob->m_useProtelFileExtension );
     aPlotOpts.SetGerberPrecision( aJob->m_precision );
+    aPlotOpts.SetGerberMergeCopper( aJob->m_mergeCopper );
 }
 
 
@@ -1246,6 +1325,7 @@ int PCBNEW_JOBS_HANDLER::doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPR
     svgPlotOptions.m_printMaskLayer = aSvgJob->m_printMaskLayer;
     svgPlotOptions.m_sketchPadsOnFabLayers = aSvgJob->m_sketchPadsOnFabLayers;
     svgPlotOptions.m_plotFrame = false;
+    svgPlotOptions.m_useSymbols = false;
 
     if( !EXPORT_SVG::Plot( brd.get(), svgPlotOptions ) )
         m_reporter->Report( _( "Error creating svg file" ) + wxS( "\n" ), RPT_SEVERITY_ERROR );
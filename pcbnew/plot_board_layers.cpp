@@ -45,6 +45,10 @@
 #include <pcb_painter.h>
 #include <gbr_metadata.h>
 #include <advanced_config.h>
+#include <core/thread_pool.h>
+
+#include <map>
+#include <mutex>
 
 /*
  * Plot a solder mask layer.  Solder mask layers have a minimum thickness value and cannot be
@@ -275,6 +279,22 @@ void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, PCB_LAYER_ID aLayer,
 }
 
 
+/**
+ * Union (and fracture, as Gerber regions cannot have holes) the copper of each net.
+ *
+ * The nets are merged on the thread pool; this is safe when the caller is itself a pool task
+ * (e.g. when exporting layers in parallel).
+ */
+static void mergeNetCopper( std::vector<SHAPE_POLY_SET*>& aPolys )
+{
+    ParallelForEach( aPolys.size(),
+            [&]( size_t aIndex )
+            {
+                aPolys[aIndex]->Fracture( SHAPE_POLY_SET::PM_FAST );
+            } );
+}
+
+
 /**
  * Plot any layer EXCEPT a solder-mask with an enforced minimum width.
  */
@@ -640,6 +660,15 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     aPlotter->StartBlock( nullptr );
     gbr_metadata.SetApertureAttrib( GBR_APERTURE_METADATA::GBR_APERTURE_ATTRIB_CONDUCTOR );
 
+    // In merged copper mode the tracks and zones of each net are collected (by net code, so the
+    // output order doesn't change from one run to the next) and plotted as a few regions.
+    bool mergeCopper = aPlotOpt.GetGerberMergeCopper()
+                            && aPlotter->GetPlotterType() == PLOT_FORMAT::GERBER
+                            && plotMode == FILLED
+                            && ( aLayerMask & LSET::AllCuMask() ).count() == 1;
+
+    std::map<int, SHAPE_POLY_SET> netCopper;
+
     // Plot tracks (not vias) :
     for( const PCB_TRACK* track : aBoard->Tracks() )
     {
@@ -649,6 +678,13 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
         if( !aLayerMask[track->GetLayer()] )
             continue;
 
+        if( mergeCopper )
+        {
+            track->TransformShapeToPolygon( netCopper[track->GetNetCode()], track->GetLayer(), 0,
+                                            maxError, ERROR_INSIDE );
+            continue;
+        }
+
         // Some track segments can be not connected (no net).
         // Set the m_NotInNet for these segments to force a empty net name in gerber file
         gbr_metadata.m_NetlistMetadata.m_NotInNet = track->GetNetname().IsEmpty();
@@ -711,7 +747,10 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 }
             }
 
-            itemplotter.PlotZone( zone, layer, mainArea );
+            if( mergeCopper && zone->GetNetCode() > 0 )
+                netCopper[zone->GetNetCode()].Append( mainArea );
+            else
+                itemplotter.PlotZone( zone, layer, mainArea );
 
             if( !islands.IsEmpty() )
             {
@@ -724,6 +763,40 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 
     aPlotter->EndBlock( nullptr );
 
+    if( mergeCopper && !netCopper.empty() )
+    {
+        PCB_LAYER_ID                 layer = ( aLayerMask & LSET::AllCuMask() ).Seq()[0];
+        std::vector<SHAPE_POLY_SET*> polys;
+
+        for( auto& [netCode, poly] : netCopper )
+            polys.push_back( &poly );
+
+        mergeNetCopper( polys );
+
+        gbr_metadata.SetApertureAttrib( GBR_APERTURE_METADATA::GBR_APERTURE_ATTRIB_CONDUCTOR );
+        gbr_metadata.SetNetAttribType( GBR_NETLIST_METADATA::GBR_NETINFO_NET );
+        gbr_metadata.SetCopper( true );
+
+        GERBER_PLOTTER* gbrPlotter = static_cast<GERBER_PLOTTER*>( aPlotter );
+
+        aPlotter->StartBlock( nullptr );
+        aPlotter->SetColor( itemplotter.getColor( layer ) );
+
+        for( auto& [netCode, poly] : netCopper )
+        {
+            const NETINFO_ITEM* net = aBoard->FindNet( netCode );
+            wxString            netname = net ? net->GetNetname() : wxString();
+
+            gbr_metadata.m_NetlistMetadata.m_NotInNet = netname.IsEmpty();
+            gbr_metadata.SetNetName( netname );
+
+            for( int ii = 0; ii < poly.OutlineCount(); ++ii )
+                gbrPlotter->PlotGerberRegion( poly.COutline( ii ), &gbr_metadata );
+        }
+
+        aPlotter->EndBlock( nullptr );
+    }
+
     // Adding drill marks, if required and if the plotter is able to plot them:
     if( aPlotOpt.GetDrillMarksType() != DRILL_MARKS::NO_DRILL_SHAPE )
         itemplotter.PlotDrillMarks();
@@ -1250,6 +1323,11 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, const PCB_PLOT_PARAMS *aPlotOpts, int aL
             // Plot the frame reference if requested
             if( aPlotOpts->GetPlotFrameRef() )
             {
+                // The drawing sheet items live in the DS_DATA_MODEL singleton and are rebuilt
+                // for each plot, so boards plotted in parallel must take turns.
+                static std::mutex           drawingSheetMutex;
+                std::lock_guard<std::mutex> lock( drawingSheetMutex );
+
                 PlotDrawingSheet( plotter, aBoard->GetProject(), aBoard->GetTitleBlock(),
                                   aBoard->GetPageSettings(), &aBoard->GetProperties(), wxT( "1" ),
                                   1, aSheetName, aSheetPath, aBoard->GetFileName(),
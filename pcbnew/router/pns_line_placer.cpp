@@ -784,7 +784,8 @@ bool LINE_PLACER::rhWalkOnly( const VECTOR2I& aP, LINE& aNewHead, LINE& aNewTail
         aNewHead.AppendVia( makeVia( aNewHead.CPoint( -1 ) ) );
     }
 
-    OPTIMIZER::Optimize( &aNewHead, effort, m_currentNode );
+    OPTIMIZER::Optimize( &aNewHead, effort, m_currentNode, VECTOR2I( 0, 0 ),
+                         Settings().OptimizerTimeLimit() );
 
     PNS_DBG( Dbg(), AddItem, &aNewHead, GREEN, 100000, wxString::Format( "walk-new-head" ) );
     PNS_DBG( Dbg(), AddItem, &aNewTail, BLUE, 100000, wxT( "walk-new-tail" ) );
@@ -986,6 +987,7 @@ bool LINE_PLACER::rhShoveOnly( const VECTOR2I& aP, LINE& aNewHead, LINE& aNewTai
 
         optimizer.SetEffortLevel( effort );
         optimizer.SetCollisionMask( ITEM::ANY_T );
+        optimizer.SetTimeLimit( Settings().OptimizerTimeLimit() );
         optimizer.Optimize( &aNewHead );
 
         return true;
@@ -60,6 +60,8 @@ NODE::NODE()
     m_maxClearance = 800000;    // fixme: depends on how thick traces are.
     m_ruleResolver = nullptr;
     m_index = new INDEX;
+    m_queryCount = 0;
+    m_branchCount = 0;
 
 #ifdef DEBUG
     allocNodes.insert( this );
@@ -151,6 +153,7 @@ NODE* NODE::Branch()
     child->m_ruleResolver = m_ruleResolver;
     child->m_root = isRoot() ? this : m_root;
     child->m_maxClearance = m_maxClearance;
+    child->m_root->m_branchCount++;
 
     // Immediate offspring of the root branch needs not copy anything. For the rest, deep-copy
     // joints, overridden item maps and pointers to stored items.
@@ -266,6 +269,8 @@ int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles,
 
     visitor.SetWorld( this, nullptr );
 
+    m_root->m_queryCount++;
+
     // first, look for colliding items in the local index
     m_index->Query( aItem, m_maxClearance, visitor );
 
@@ -259,6 +259,18 @@ public:
         return m_depth;
     }
 
+    ///< Return the number of collision queries made on the whole node hierarchy (for profiling).
+    int64_t QueryCount() const
+    {
+        return m_root->m_queryCount;
+    }
+
+    ///< Return the number of branches created from the whole node hierarchy (for profiling).
+    int64_t BranchCount() const
+    {
+        return m_root->m_branchCount;
+    }
+
     /**
      * Find items colliding (closer than clearance) with the item \a aItem.
      *
@@ -549,6 +561,9 @@ private:
     int             m_depth;            ///< depth of the node (number of parent nodes in the
                                         ///< inheritance chain)
 
+    int64_t         m_queryCount;       ///< statistics, only maintained in the root node
+    int64_t         m_branchCount;
+
     std::vector< std::unique_ptr<SHAPE> > m_edgeExclusions;
 
     std::unordered_set<ITEM*> m_garbageItems;
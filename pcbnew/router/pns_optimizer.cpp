@@ -464,6 +464,12 @@ bool OPTIMIZER::mergeObtuse( LINE* aLine )
 
     while( 1 )
     {
+        if( timeLimitExpired() )
+        {
+            line = current_path;
+            return current_path.SegmentCount() < segs_pre;
+        }
+
         iter++;
         int n_segs = current_path.SegmentCount();
         int max_step = n_segs - 2;
@@ -552,7 +558,7 @@ bool OPTIMIZER::mergeFull( LINE* aLine )
         if( step > max_step )
             step = max_step;
 
-        if( step < 1 )
+        if( step < 1 || timeLimitExpired() )
             break;
 
         bool found_anything = mergeStep( aLine, current_path, step );
@@ -670,11 +676,11 @@ bool OPTIMIZER::Optimize( LINE* aLine, LINE* aResult, LINE* aRoot )
         rv |= mergeColinear( aResult );
 
     // TODO: Fix for arcs
-    if( !hasArcs && m_effortLevel & SMART_PADS )
+    if( !hasArcs && m_effortLevel & SMART_PADS && !timeLimitExpired() )
         rv |= runSmartPads( aResult );
 
     // TODO: Fix for arcs
-    if( !hasArcs && m_effortLevel & FANOUT_CLEANUP )
+    if( !hasArcs && m_effortLevel & FANOUT_CLEANUP && !timeLimitExpired() )
         rv |= fanoutCleanup( aResult );
 
     return rv;
@@ -699,6 +705,9 @@ bool OPTIMIZER::mergeStep( LINE* aLine, SHAPE_LINE_CHAIN& aCurrentPath, int step
 
     for( int n = 0; n < n_segs - step; n++ )
     {
+        if( timeLimitExpired() )
+            return false;
+
         // Do not attempt to merge false segments that are part of an arc
         if( aCurrentPath.IsArcSegment( n )
             || aCurrentPath.IsArcSegment( static_cast<std::size_t>( n ) + step ) )
@@ -1090,12 +1099,14 @@ bool OPTIMIZER::runSmartPads( LINE* aLine )
 }
 
 
-bool OPTIMIZER::Optimize( LINE* aLine, int aEffortLevel, NODE* aWorld, const VECTOR2I& aV )
+bool OPTIMIZER::Optimize( LINE* aLine, int aEffortLevel, NODE* aWorld, const VECTOR2I& aV,
+                          const TIME_LIMIT& aTimeLimit )
 {
     OPTIMIZER opt( aWorld );
 
     opt.SetEffortLevel( aEffortLevel );
     opt.SetCollisionMask( -1 );
+    opt.SetTimeLimit( aTimeLimit );
 
     if( aEffortLevel & OPTIMIZER::PRESERVE_VERTEX )
         opt.SetPreserveVertex( aV );
@@ -1347,7 +1358,7 @@ bool OPTIMIZER::mergeDpSegments( DIFF_PAIR* aPair )
         if( step_n > max_step_n )
             step_n = max_step_n;
 
-        if( step_p < 1 && step_n < 1 )
+        if( ( step_p < 1 && step_n < 1 ) || timeLimitExpired() )
             break;
 
         bool found_anything_p = false;
@@ -30,6 +30,7 @@
 #include <geometry/shape_line_chain.h>
 
 #include "range.h"
+#include "time_limit.h"
 
 
 namespace PNS {
@@ -114,7 +115,8 @@ public:
 
     ///< A quick shortcut to optimize a line without creating and setting up an optimizer.
     static bool Optimize( LINE* aLine, int aEffortLevel, NODE* aWorld,
-                          const VECTOR2I& aV = VECTOR2I(0, 0) );
+                          const VECTOR2I& aV = VECTOR2I(0, 0),
+                          const TIME_LIMIT& aTimeLimit = TIME_LIMIT() );
 
     bool Optimize( LINE* aLine, LINE* aResult = nullptr, LINE* aRoot = nullptr );
     bool Optimize( DIFF_PAIR* aPair );
@@ -153,6 +155,17 @@ public:
         m_restrictAreaIsStrict = aStrict;
     }
 
+    /**
+     * Limit the time spent optimizing, starting from now and shared by all subsequent
+     * Optimize() calls.  When the limit expires the passes stop early and the best
+     * (collision-free) result found so far is kept.  A limit of 0 disables the budget.
+     */
+    void SetTimeLimit( const TIME_LIMIT& aLimit )
+    {
+        m_timeLimit = aLimit;
+        m_timeLimit.Restart();
+    }
+
 private:
     static const int MaxCachedItems = 256;
 
@@ -196,6 +209,11 @@ private:
 
     ITEM* findPadOrVia( int aLayer, NET_HANDLE aNet, const VECTOR2I& aP ) const;
 
+    bool timeLimitExpired() const
+    {
+        return m_timeLimit.Get() > 0 && m_timeLimit.Expired();
+    }
+
 private:
     SHAPE_INDEX_LIST<ITEM*>                m_cache;
     std::vector<OPT_CONSTRAINT*>           m_constraints;
@@ -209,6 +227,7 @@ private:
     std::pair<int, int> m_restrictedVertexRange;
     BOX2I               m_restrictArea;
     bool                m_restrictAreaIsStrict;
+    TIME_LIMIT          m_timeLimit;
 };
 
 
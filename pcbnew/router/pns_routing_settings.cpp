@@ -42,6 +42,7 @@ ROUTING_SETTINGS::ROUTING_SETTINGS( JSON_SETTINGS* aParent, const std::string& a
     m_startDiagonal = false;
     m_shoveIterationLimit = 250;
     m_shoveTimeLimit = 1000;
+    m_optimizerTimeLimit = 0;
     m_walkaroundIterationLimit = 40;
     m_jumpOverObstacles = false;
     m_smoothDraggedSegments = true;
@@ -54,6 +55,7 @@ ROUTING_SETTINGS::ROUTING_SETTINGS( JSON_SETTINGS* aParent, const std::string& a
     m_walkaroundHugLengthThreshold = 1.5;
     m_autoPosture = true;
     m_fixAllSegments = true;
+    m_speculativeShove = false;
     m_viaForcePropIterationLimit = 40;
 
     m_params.emplace_back( new PARAM<int>( "mode", reinterpret_cast<int*>( &m_routingMode ),
@@ -82,6 +84,17 @@ ROUTING_SETTINGS::ROUTING_SETTINGS( JSON_SETTINGS* aParent, const std::string& a
             },
             1000 ) );
 
+    m_params.emplace_back( new PARAM_LAMBDA<int>( "optimizer_time_limit",
+            [this] () -> int
+            {
+                return m_optimizerTimeLimit.Get();
+            },
+            [this] ( int aVal )
+            {
+                m_optimizerTimeLimit.Set( aVal );
+            },
+            30 ) );
+
     m_params.emplace_back( new PARAM<int>( "walkaround_iteration_limit", &m_walkaroundIterationLimit, 40 ) );
     m_params.emplace_back( new PARAM<bool>( "jump_over_obstacles",       &m_jumpOverObstacles, false ) );
 
@@ -96,6 +109,7 @@ ROUTING_SETTINGS::ROUTING_SETTINGS( JSON_SETTINGS* aParent, const std::string& a
 
     m_params.emplace_back( new PARAM<bool>( "auto_posture",     &m_autoPosture,       true ) );
     m_params.emplace_back( new PARAM<bool>( "fix_all_segments", &m_fixAllSegments,    true ) );
+    m_params.emplace_back( new PARAM<bool>( "speculative_shove", &m_speculativeShove, false ) );
 
     m_params.emplace_back( new PARAM_ENUM<DIRECTION_45::CORNER_MODE>(
             "corner_mode", &m_cornerMode, DIRECTION_45::CORNER_MODE::MITERED_45,
@@ -122,6 +136,12 @@ TIME_LIMIT ROUTING_SETTINGS::ShoveTimeLimit() const
 }
 
 
+TIME_LIMIT ROUTING_SETTINGS::OptimizerTimeLimit() const
+{
+    return TIME_LIMIT( m_optimizerTimeLimit );
+}
+
+
 int ROUTING_SETTINGS::ShoveIterationLimit() const
 {
     return m_shoveIterationLimit;
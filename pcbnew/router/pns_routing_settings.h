@@ -134,6 +134,11 @@ public:
     int WalkaroundIterationLimit() const { return m_walkaroundIterationLimit; };
     TIME_LIMIT WalkaroundTimeLimit() const;
 
+    ///< Time budget for a single optimizer run (0 = unlimited).  Only the settings loaded for
+    ///< the interactive router default to a budget; standalone settings are unlimited.
+    TIME_LIMIT OptimizerTimeLimit() const;
+    void SetOptimizerTimeLimit( int aLimit ) { m_optimizerTimeLimit.Set( aLimit ); }
+
     void SetSnapToTracks( bool aSnap ) { m_snapToTracks = aSnap; }
     void SetSnapToPads( bool aSnap ) { m_snapToPads = aSnap; }
 
@@ -154,6 +159,11 @@ public:
 
     double WalkaroundHugLengthThreshold() const { return m_walkaroundHugLengthThreshold; }
 
+    ///< Evaluate all the shove candidates for an obstacle concurrently and keep the best one
+    ///< instead of the first one that fits.
+    bool GetSpeculativeShove() const { return m_speculativeShove; }
+    void SetSpeculativeShove( bool aEnable ) { m_speculativeShove = aEnable; }
+
     int ViaForcePropIterationLimit() const { return m_viaForcePropIterationLimit; }
     void SetViaForcePropIterationLimit(int aLimit) { m_viaForcePropIterationLimit = aLimit; }
 
@@ -173,6 +183,7 @@ private:
     bool m_optimizeEntireDraggedTrack;
     bool m_autoPosture;
     bool m_fixAllSegments;
+    bool m_speculativeShove;
 
     DIRECTION_45::CORNER_MODE m_cornerMode;
 
@@ -186,6 +197,7 @@ private:
 
     TIME_LIMIT m_shoveTimeLimit;
     TIME_LIMIT m_walkaroundTimeLimit;
+    TIME_LIMIT m_optimizerTimeLimit;
 };
 
 }
@@ -20,6 +20,7 @@
  */
 
 #include <deque>
+#include <future>
 #include <cassert>
 #include <math/box2.h>
 
@@ -40,6 +41,8 @@
 
 #include "time_limit.h"
 
+#include <core/thread_pool.h>
+
 // fixme - move all logger calls to debug decorator
 
 typedef VECTOR2I::extended_type ecoord;
@@ -257,53 +260,105 @@ SHOVE::SHOVE_STATUS SHOVE::shoveLineFromLoneVia( const LINE& aCurLine, const LIN
 
 
 /*
- * Re-walk aObstacleLine around the given set of hulls, returning the result in aResultLine.
+ * Walk aObstacleLine around all the hulls in aHulls, using the traversal order and direction
+ * encoded in aAttempt.  This is pure geometry (no world queries), so it may run on any thread
+ * as long as aDbg is null.
  */
+bool SHOVE::walkObstacleAroundHulls( const LINE& aObstacleLine, const HULL_SET& aHulls,
+                                     int aAttempt, SHAPE_LINE_CHAIN& aPath,
+                                     DEBUG_DECORATOR* aDbg ) const
+{
+    const SHAPE_LINE_CHAIN& obs = aObstacleLine.CLine();
+
+    bool invertTraversal = ( aAttempt >= 2 );
+    bool clockwise = aAttempt % 2;
+
+    LINE l( aObstacleLine );
+
+    aPath = l.CLine();
+
+    for( int i = 0; i < (int) aHulls.size(); i++ )
+    {
+        const SHAPE_LINE_CHAIN& hull = aHulls[invertTraversal ? aHulls.size() - 1 - i : i];
+
+        PNS_DBG( aDbg, AddShape, &hull, YELLOW, 10000, wxString::Format( "hull[%d]", i ) );
+        PNS_DBG( aDbg, AddShape, &aPath, WHITE, l.Width(), wxString::Format( "path[%d]", i ) );
+        PNS_DBG( aDbg, AddShape, &obs, LIGHTGRAY, aObstacleLine.Width(),  wxString::Format( "obs[%d]", i ) );
+
+        if( !l.Walkaround( hull, aPath, clockwise ) )
+        {
+            PNS_DBG( aDbg, Message, wxString::Format( wxT( "Fail-Walk %s %s %d\n" ),
+                                                      hull.Format().c_str(),
+                                                      l.CLine().Format().c_str(),
+                                                      clockwise? 1 : 0) );
+            return false;
+        }
+
+        PNS_DBG( aDbg, AddShape, &aPath, WHITE, l.Width(), wxString::Format( "path-presimp[%d]", i ) );
+
+        aPath.Simplify();
+
+        PNS_DBG( aDbg, AddShape, &aPath, WHITE, l.Width(), wxString::Format( "path-postsimp[%d]", i ) );
+
+        l.SetShape( aPath );
+    }
+
+    return true;
+}
+
+
 SHOVE::SHOVE_STATUS SHOVE::shoveLineToHullSet( const LINE& aCurLine, const LINE& aObstacleLine,
                                                LINE& aResultLine, const HULL_SET& aHulls )
 {
+    const int               attemptCount = 4;
     const SHAPE_LINE_CHAIN& obs = aObstacleLine.CLine();
+    bool                    speculative = Settings().GetSpeculativeShove();
+
+    SHAPE_LINE_CHAIN        walks[attemptCount];
+    bool                    walkOk[attemptCount] = { false };
+
+    std::optional<SHAPE_LINE_CHAIN> best;
+    long long int                   bestLength = 0;
 
     int attempt;
 
     PNS_DBG( Dbg(), BeginGroup, "shove-details", 1 );
 
-    for( attempt = 0; attempt < 4; attempt++ )
+    if( speculative )
     {
-        bool invertTraversal = ( attempt >= 2 );
-        bool clockwise = attempt % 2;
-        int vFirst = -1, vLast = -1;
-
-        LINE l( aObstacleLine );
-        SHAPE_LINE_CHAIN path( l.CLine() );
+        // Walking around the hulls doesn't touch the world, so compute all the candidate
+        // shoves at once and only run the collision checks below on the UI thread.
+        thread_pool&                   tp = GetKiCadThreadPool();
+        std::vector<std::future<bool>> walkers;
 
-        for( int i = 0; i < (int) aHulls.size(); i++ )
+        for( attempt = 0; attempt < attemptCount; attempt++ )
         {
-            const SHAPE_LINE_CHAIN& hull = aHulls[invertTraversal ? aHulls.size() - 1 - i : i];
-
-            PNS_DBG( Dbg(), AddShape, &hull, YELLOW, 10000, wxString::Format( "hull[%d]", i ) );
-            PNS_DBG( Dbg(), AddShape, &path, WHITE, l.Width(), wxString::Format( "path[%d]", i ) );
-            PNS_DBG( Dbg(), AddShape, &obs, LIGHTGRAY, aObstacleLine.Width(),  wxString::Format( "obs[%d]", i ) );
+            walkers.emplace_back( tp.submit(
+                    [&, attempt]() -> bool
+                    {
+                        return walkObstacleAroundHulls( aObstacleLine, aHulls, attempt,
+                                                        walks[attempt], nullptr );
+                    } ) );
+        }
 
-            if( !l.Walkaround( hull, path, clockwise ) )
-            {
-                PNS_DBG( Dbg(), Message, wxString::Format( wxT( "Fail-Walk %s %s %d\n" ),
-                                                           hull.Format().c_str(),
-                                                           l.CLine().Format().c_str(),
-                                                           clockwise? 1 : 0) );
+        for( attempt = 0; attempt < attemptCount; attempt++ )
+            walkOk[attempt] = walkers[attempt].get();
+    }
 
-                PNS_DBGN( Dbg(), EndGroup );
-                return SH_INCOMPLETE;
-            }
+    for( attempt = 0; attempt < attemptCount; attempt++ )
+    {
+        int vFirst = -1, vLast = -1;
 
-            PNS_DBG( Dbg(), AddShape, &path, WHITE, l.Width(), wxString::Format( "path-presimp[%d]", i ) );
+        SHAPE_LINE_CHAIN& path = walks[attempt];
 
-            path.Simplify();
+        if( !speculative )
+            walkOk[attempt] = walkObstacleAroundHulls( aObstacleLine, aHulls, attempt, path, Dbg() );
 
-            PNS_DBG( Dbg(), AddShape, &path, WHITE, l.Width(), wxString::Format( "path-postsimp[%d]", i ) );
+        if( !walkOk[attempt] )
+            break;
 
-            l.SetShape( path );
-        }
+        LINE l( aObstacleLine );
+        l.SetShape( path );
 
         for( int i = 0; i < std::min( path.PointCount(), obs.PointCount() ); i++ )
         {
@@ -374,15 +429,34 @@ SHOVE::SHOVE_STATUS SHOVE::shoveLineToHullSet( const LINE& aCurLine, const LINE&
             continue;
         }
 
-        aResultLine.SetShape( l.CLine() );
+        if( !speculative )
+        {
+            aResultLine.SetShape( l.CLine() );
 
-        PNS_DBGN( Dbg(), EndGroup );
+            PNS_DBGN( Dbg(), EndGroup );
 
-        return SH_OK;
+            return SH_OK;
+        }
+
+        // In speculative mode all the candidates are already computed, so pick the one that
+        // disturbs the obstacle the least instead of the first one that happens to fit.
+        if( !best || path.Length() < bestLength )
+        {
+            best = path;
+            bestLength = path.Length();
+        }
     }
 
     PNS_DBGN( Dbg(), EndGroup );
 
+    if( best )
+    {
+        PNS_DBG( Dbg(), Message, wxString::Format( wxT( "speculative shove picked length %lld" ),
+                                                   bestLength ) );
+        aResultLine.SetShape( *best );
+        return SH_OK;
+    }
+
     return SH_INCOMPLETE;
 }
 
@@ -1909,6 +1983,7 @@ void SHOVE::runOptimizer( NODE* aNode )
 
     optimizer.SetEffortLevel( optFlags & ~m_optFlagDisableMask );
     optimizer.SetCollisionMask( ITEM::ANY_T );
+    optimizer.SetTimeLimit( Settings().OptimizerTimeLimit() );
 
     for( int pass = 0; pass < n_passes; pass++ )
     {
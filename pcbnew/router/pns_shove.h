@@ -115,6 +115,10 @@ private:
     SHOVE_STATUS shoveLineToHullSet( const LINE& aCurLine, const LINE& aObstacleLine,
                                      LINE& aResultLine, const HULL_SET& aHulls );
 
+    bool walkObstacleAroundHulls( const LINE& aObstacleLine, const HULL_SET& aHulls,
+                                  int aAttempt, SHAPE_LINE_CHAIN& aPath,
+                                  DEBUG_DECORATOR* aDbg ) const;
+
     NODE* reduceSpringback( const ITEM_SET& aHeadSet, VIA_HANDLE& aDraggedVia );
 
     bool pushSpringback( NODE* aNode, const OPT_BOX2I& aAffectedArea, VIA* aDraggedVia );
@@ -148,11 +148,17 @@ int BOARD_REANNOTATE_TOOL::ReannotateDuplicates( const PCB_SELECTION& aSelection
                    return ii < 0;
                } );
 
+    // Runs of numbers (first, last) known to be used for a stem.  The footprints are sorted by
+    // reference, so the search for a free number can skip the numbers the previous footprints
+    // already went through instead of walking them again (quadratic when pasting many copies).
+    std::map<wxString, std::pair<int, int>> usedRuns;
+
     // 3. Iterate through the sorted list of footprints
     for( FOOTPRINT* fp : fpInSelection )
     {
         wxString stem = UTIL::GetRefDesPrefix( fp->GetReference() );
         int      value = UTIL::GetRefDesNumber( fp->GetReference() );
+        int      firstValue = -1;
         bool     duplicate = false;
 
         while( usedDesignatorsMap.find( fp->GetReference() ) != usedDesignatorsMap.end() )
@@ -176,11 +182,34 @@ int BOARD_REANNOTATE_TOOL::ReannotateDuplicates( const PCB_SELECTION& aSelection
             else
                 ++value;
 
+            if( firstValue < 0 )
+                firstValue = value;
+
+            auto run = usedRuns.find( stem );
+
+            if( run != usedRuns.end() && value >= run->second.first && value <= run->second.second )
+                value = run->second.second + 1;
+
             fp->SetReference( stem + std::to_string( value ) );
         }
 
         if( duplicate )
+        {
             usedDesignatorsMap.insert( { fp->GetReference(), fp->m_Uuid } );
+
+            // All the numbers from firstValue to value are used now
+            auto run = usedRuns.find( stem );
+
+            if( run != usedRuns.end() && firstValue >= run->second.first
+                    && firstValue <= run->second.second + 1 )
+            {
+                run->second.second = std::max( run->second.second, value );
+            }
+            else
+            {
+                usedRuns[stem] = { firstValue, value };
+            }
+        }
     }
 
     return 0;
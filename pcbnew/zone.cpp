@@ -165,6 +165,8 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
                 m_insulatedIslands[layer] = aZone.m_insulatedIslands.at( layer );
             } );
 
+    clearLODFilledPolys();
+
     m_borderStyle             = aZone.m_borderStyle;
     m_borderHatchPitch        = aZone.m_borderHatchPitch;
     m_borderHatchLines        = aZone.m_borderHatchLines;
@@ -217,6 +219,8 @@ bool ZONE::UnFill()
         pair.second->RemoveAllContours();
     }
 
+    clearLODFilledPolys();
+
     m_isFilled = false;
     m_fillFlags.reset();
 
@@ -668,6 +672,8 @@ void ZONE::Move( const VECTOR2I& offset )
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Move( offset );
 
+    clearLODFilledPolys();
+
     /*
      * move boundingbox cache
      *
@@ -720,6 +726,8 @@ void ZONE::Rotate( const VECTOR2I& aCentre, const EDA_ANGLE& aAngle )
     /* rotate filled areas: */
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Rotate( aAngle, aCentre );
+
+    clearLODFilledPolys();
 }
 
 
@@ -752,6 +760,8 @@ void ZONE::Mirror( const VECTOR2I& aMirrorRef, bool aMirrorLeftRight )
 
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Mirror( aMirrorLeftRight, !aMirrorLeftRight, aMirrorRef );
+
+    clearLODFilledPolys();
 }
 
 
@@ -1088,6 +1098,35 @@ void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer )
 }
 
 
+std::shared_ptr<SHAPE_POLY_SET> ZONE::GetLODFilledPolysList( PCB_LAYER_ID aLayer, int aMaxError,
+                                                             bool aTriangulate ) const
+{
+    const std::shared_ptr<SHAPE_POLY_SET>& source = GetFilledPolysList( aLayer );
+
+    std::lock_guard<std::mutex> lock( m_lodFillsLock );
+
+    LOD_FILL& lodFill = m_lodFills[{ aLayer, aMaxError }];
+
+    // The fills are replaced when refilling, but also moved or rotated in place, which clears
+    // the whole cache.
+    if( !lodFill.m_fill || lodFill.m_source.lock() != source )
+    {
+        lodFill.m_source = source;
+        lodFill.m_fill = std::make_shared<SHAPE_POLY_SET>( source->CloneDropTriangulation() );
+        lodFill.m_fill->Decimate( aMaxError );
+        lodFill.m_triangulated = false;
+    }
+
+    if( aTriangulate && !lodFill.m_triangulated )
+    {
+        lodFill.m_fill->CacheTriangulation( true, true );
+        lodFill.m_triangulated = true;
+    }
+
+    return lodFill.m_fill;
+}
+
+
 bool ZONE::IsIsland( PCB_LAYER_ID aLayer, int aPolyIdx ) const
 {
     if( GetNetCode() < 1 )
@@ -631,12 +631,25 @@ public:
      */
     void CacheTriangulation( PCB_LAYER_ID aLayer = UNDEFINED_LAYER );
 
+    /**
+     * Return the filled polygons of \a aLayer simplified to \a aMaxError (see
+     * SHAPE_POLY_SET::Decimate()), to draw the zone when zoomed out.
+     *
+     * The result is kept for each layer and error until the zone is refilled or changed, so it
+     * is built once per level of detail rather than on every redraw.
+     *
+     * @param aTriangulate also cache the triangulation of the result.
+     */
+    std::shared_ptr<SHAPE_POLY_SET> GetLODFilledPolysList( PCB_LAYER_ID aLayer, int aMaxError,
+                                                           bool aTriangulate ) const;
+
     /**
      * Set the list of filled polygons.
      */
     void SetFilledPolysList( PCB_LAYER_ID aLayer, const SHAPE_POLY_SET& aPolysList )
     {
         m_FilledPolysList[aLayer] = std::make_shared<SHAPE_POLY_SET>( aPolysList );
+        clearLODFilledPolys();
     }
 
     /**
@@ -796,6 +809,7 @@ public:
     void SetFillPoly( PCB_LAYER_ID aLayer, SHAPE_POLY_SET* aPoly )
     {
         m_FilledPolysList[ aLayer ] = std::make_shared<SHAPE_POLY_SET>( *aPoly );
+        clearLODFilledPolys();
         SetFillFlag( aLayer, true );
     }
 
@@ -919,6 +933,24 @@ protected:
 
     /// Lock used for multi-threaded filling on multi-layer zones
     std::mutex m_lock;
+
+    /// A simplified fill (see GetLODFilledPolysList()), and the fill it was made from
+    struct LOD_FILL
+    {
+        std::weak_ptr<SHAPE_POLY_SET>   m_source;
+        std::shared_ptr<SHAPE_POLY_SET> m_fill;
+        bool                            m_triangulated = false;
+    };
+
+    /// Simplified fills for each layer and max error, built when drawing zoomed out
+    mutable std::map<std::pair<PCB_LAYER_ID, int>, LOD_FILL> m_lodFills;
+    mutable std::mutex                                       m_lodFillsLock;
+
+    void clearLODFilledPolys()
+    {
+        std::lock_guard<std::mutex> lock( m_lodFillsLock );
+        m_lodFills.clear();
+    }
 };
 
 
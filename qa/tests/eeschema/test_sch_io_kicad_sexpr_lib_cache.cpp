@@ -0,0 +1,173 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the lazy loading of SCH_IO_KICAD_SEXPR_LIB_CACHE.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <lib_symbol.h>
+#include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_lib_cache.h>
+
+
+static wxString libraryPath( const wxString& aRelativePath )
+{
+    wxFileName fn( wxString( KI_TEST::GetEeschemaTestDataDir() ) + aRelativePath );
+
+    return fn.GetFullPath();
+}
+
+
+static const std::vector<wxString> libraries = {
+    wxT( "netlists/test_hier_no_connect/TEST_LIB.kicad_sym" ),
+    wxT( "spice_netlists/legacy_pspice/schematic_libspice.kicad_sym" ),
+    wxT( "spice_netlists/legacy_sources/v_i_sources.kicad_sym" ),
+    wxT( "spice_netlists/tlines/Transmission_Line.kicad_sym" ),
+};
+
+
+BOOST_AUTO_TEST_SUITE( SchIoKicadSexprLibCache )
+
+
+/**
+ * Symbols parsed one at a time must be the same as when parsing the whole library.
+ */
+BOOST_AUTO_TEST_CASE( LazyMatchesFullLoad )
+{
+    for( const wxString& relPath : libraries )
+    {
+        BOOST_TEST_CONTEXT( relPath )
+        {
+            SCH_IO_KICAD_SEXPR_LIB_CACHE full( libraryPath( relPath ) );
+            SCH_IO_KICAD_SEXPR_LIB_CACHE lazy( libraryPath( relPath ) );
+
+            full.Load();
+            lazy.LoadLazily();
+
+            // Load() parses everything, so this fails if LoadLazily() fell back to it.
+            BOOST_CHECK( lazy.GetParsedSymbols().empty() );
+
+            BOOST_CHECK_EQUAL( lazy.GetFileFormatVersionAtLoad(),
+                               full.GetFileFormatVersionAtLoad() );
+
+            wxArrayString names;
+            lazy.GetSymbolNames( names, false );
+
+            BOOST_REQUIRE_EQUAL( names.size(), full.GetSymbolMap().size() );
+
+            // Parse the symbols in reverse order so derived symbols come before their parents
+            for( int ii = (int) names.size() - 1; ii >= 0; --ii )
+            {
+                LIB_SYMBOL* expected = full.GetSymbolMap().at( names[ii] );
+                LIB_SYMBOL* symbol = lazy.FindSymbol( names[ii] );
+
+                BOOST_REQUIRE( symbol );
+                BOOST_CHECK_EQUAL( symbol->Compare( *expected ), 0 );
+                BOOST_CHECK_EQUAL( symbol->IsPower(), expected->IsPower() );
+                BOOST_CHECK_EQUAL( symbol->IsAlias(), expected->IsAlias() );
+            }
+
+            BOOST_CHECK( lazy.FindSymbol( wxT( "not_a_symbol" ) ) == nullptr );
+        }
+    }
+}
+
+
+/**
+ * Power symbols can be listed without parsing the library.
+ */
+BOOST_AUTO_TEST_CASE( PowerSymbolsOnly )
+{
+    size_t powerSymbolCount = 0;
+
+    for( const wxString& relPath : libraries )
+    {
+        BOOST_TEST_CONTEXT( relPath )
+        {
+            SCH_IO_KICAD_SEXPR_LIB_CACHE full( libraryPath( relPath ) );
+            SCH_IO_KICAD_SEXPR_LIB_CACHE lazy( libraryPath( relPath ) );
+
+            full.Load();
+            lazy.LoadLazily();
+
+            std::vector<LIB_SYMBOL*> symbols;
+            lazy.GetSymbols( symbols, true );
+
+            size_t expectedCount = 0;
+
+            for( const auto& [ name, symbol ] : full.GetSymbolMap() )
+            {
+                if( symbol->IsPower() )
+                    expectedCount++;
+            }
+
+            BOOST_CHECK_EQUAL( symbols.size(), expectedCount );
+
+            for( LIB_SYMBOL* symbol : symbols )
+                BOOST_CHECK( symbol->IsPower() );
+
+            // Only the power symbols were parsed
+            BOOST_CHECK_EQUAL( lazy.GetParsedSymbols().size(), expectedCount );
+
+            lazy.ParseAllSymbols();
+            BOOST_CHECK_EQUAL( lazy.GetParsedSymbols().size(), full.GetSymbolMap().size() );
+
+            powerSymbolCount += expectedCount;
+        }
+    }
+
+    // Make sure the libraries above do exercise the power symbols.
+    BOOST_CHECK_GT( powerSymbolCount, 0 );
+}
+
+
+/**
+ * Caches reading the same library lazily share its contents but not its symbols, which the
+ * library tables modify after loading them.
+ */
+BOOST_AUTO_TEST_CASE( SharedContentsPrivateSymbols )
+{
+    wxString path = libraryPath( libraries[1] );
+
+    SCH_IO_KICAD_SEXPR_LIB_CACHE first( path );
+    SCH_IO_KICAD_SEXPR_LIB_CACHE second( path );
+
+    first.LoadLazily();
+    second.LoadLazily();
+
+    LIB_SYMBOL* firstSymbol = first.FindSymbol( wxT( "GND" ) );
+    LIB_SYMBOL* secondSymbol = second.FindSymbol( wxT( "GND" ) );
+
+    BOOST_REQUIRE( firstSymbol && secondSymbol );
+    BOOST_CHECK( firstSymbol != secondSymbol );
+
+    firstSymbol->SetLibId( LIB_ID( wxT( "first" ), wxT( "GND" ) ) );
+
+    BOOST_CHECK( secondSymbol->GetLibId().GetLibNickname().empty() );
+    BOOST_CHECK_EQUAL( second.GetParsedSymbols().size(), 1 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,159 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <base_units.h>
+#include <core/profile.h>
+#include <geometry/shape_poly_set.h>
+#include <plotters/plotter_gerber.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <wx/filename.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+
+/**
+ * Plot a Gerber layer flashing many pads which each need their own aperture (rotated
+ * rectangles and custom pad shapes), to measure the aperture lookup cost.
+ */
+
+
+typedef std::function<void( GERBER_PLOTTER&, int )> FLASH_FUNC;
+
+
+static double plotPads( const wxString& aFileName, int aCount, const FLASH_FUNC& aFlash )
+{
+    GERBER_PLOTTER plotter;
+
+    plotter.SetViewport( VECTOR2I( 0, 0 ), pcbIUScale.IU_PER_MILS / 10, 1.0, false );
+    plotter.SetGerberCoordinatesFormat( 6 );
+    plotter.UseX2format( true );
+
+    if( !plotter.OpenFile( aFileName ) || !plotter.StartPlot( wxT( "1" ) ) )
+        return -1.0;
+
+    PROF_TIMER timer;
+
+    for( int ii = 0; ii < aCount; ++ii )
+        aFlash( plotter, ii );
+
+    double timeMs = timer.msecs();
+
+    plotter.EndPlot();
+
+    return timeMs;
+}
+
+
+static VECTOR2I padPosition( int aIndex )
+{
+    // A 200 x N grid with a 1mm pitch
+    return VECTOR2I( ( aIndex % 200 ) * pcbIUScale.mmToIU( 1.0 ),
+                     ( aIndex / 200 ) * pcbIUScale.mmToIU( 1.0 ) );
+}
+
+
+static void flashRotatedRect( GERBER_PLOTTER& aPlotter, int aIndex )
+{
+    // Each pad has its own rotation, so needs its own aperture
+    EDA_ANGLE angle( 0.01 * ( aIndex + 1 ), DEGREES_T );
+    VECTOR2I  size( pcbIUScale.mmToIU( 0.6 ), pcbIUScale.mmToIU( 0.3 ) );
+
+    aPlotter.FlashPadRect( padPosition( aIndex ), size, angle, FILLED, nullptr );
+}
+
+
+static void flashCustomPad( GERBER_PLOTTER& aPlotter, int aIndex )
+{
+    // An L shape with a size depending on the pad, so each one needs its own aperture macro
+    int            len = pcbIUScale.mmToIU( 0.4 ) + aIndex * 100;
+    int            width = pcbIUScale.mmToIU( 0.2 );
+    VECTOR2I       pos = padPosition( aIndex );
+    SHAPE_POLY_SET poly;
+
+    poly.NewOutline();
+    poly.Append( pos );
+    poly.Append( pos + VECTOR2I( len, 0 ) );
+    poly.Append( pos + VECTOR2I( len, width ) );
+    poly.Append( pos + VECTOR2I( width, width ) );
+    poly.Append( pos + VECTOR2I( width, len ) );
+    poly.Append( pos + VECTOR2I( 0, len ) );
+
+    aPlotter.FlashPadCustom( pos, VECTOR2I( len, len ), ANGLE_0, &poly, FILLED, nullptr );
+}
+
+
+enum GERBER_APERTURE_BENCHMARK_RET_CODES
+{
+    CANNOT_WRITE = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int gerber_aperture_benchmark_main( int argc, char* argv[] )
+{
+    int count = 20000;
+
+    if( argc > 1 )
+        count = std::max( 1, atoi( argv[1] ) );
+
+    wxString fileName = wxFileName::CreateTempFileName( wxT( "gbr_bench" ) );
+
+    printf( "%-24s %10s %12s\n", "pads", "count", "time [ms]" );
+
+    struct
+    {
+        const char* m_name;
+        FLASH_FUNC  m_func;
+    } cases[] = {
+        { "rotated rectangles", flashRotatedRect },
+        { "custom shapes",      flashCustomPad },
+    };
+
+    for( const auto& benchCase : cases )
+    {
+        double timeMs = plotPads( fileName, count, benchCase.m_func );
+
+        if( timeMs < 0.0 )
+        {
+            wxRemoveFile( fileName );
+            return GERBER_APERTURE_BENCHMARK_RET_CODES::CANNOT_WRITE;
+        }
+
+        printf( "%-24s %10d %12.1f\n", benchCase.m_name, count, timeMs );
+    }
+
+    wxRemoveFile( fileName );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "gerber_aperture_benchmark",
+        "Benchmark flashing Gerber pads which each need their own aperture",
+        gerber_aperture_benchmark_main,
+} );
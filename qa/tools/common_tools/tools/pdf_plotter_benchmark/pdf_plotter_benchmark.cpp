@@ -0,0 +1,211 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <base_units.h>
+#include <core/profile.h>
+#include <font/font.h>
+#include <plotters/plotters_pslike.h>
+#include <render_settings.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <wx/filename.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+
+/**
+ * Plot a multi-sheet schematic-like document to PDF: every sheet holds a grid of symbols with
+ * pins, pin numbers, references and wires, which is the geometry a real schematic repeats the
+ * most.  A last page flashes rounded rectangle pads like a board plot.  Reports the time and the
+ * size of the file.
+ */
+
+
+class BENCHMARK_RENDER_SETTINGS : public KIGFX::RENDER_SETTINGS
+{
+public:
+    BENCHMARK_RENDER_SETTINGS()
+    {
+        m_background = COLOR4D::WHITE;
+        SetDefaultPenWidth( schIUScale.MilsToIU( 6 ) );
+    }
+
+    COLOR4D GetColor( const KIGFX::VIEW_ITEM* aItem, int aLayer ) const override
+    {
+        return COLOR4D::BLACK;
+    }
+
+    const COLOR4D& GetBackgroundColor() const override { return m_background; }
+    void SetBackgroundColor( const COLOR4D& aColor ) override { m_background = aColor; }
+    const COLOR4D& GetGridColor() override { return m_background; }
+    const COLOR4D& GetCursorColor() override { return m_background; }
+
+private:
+    COLOR4D m_background;
+};
+
+
+static void plotSymbol( PDF_PLOTTER& aPlotter, const VECTOR2I& aPos, int aIndex )
+{
+    const int      pinCount = 8;
+    const int      pinPitch = schIUScale.MilsToIU( 100 );
+    const int      pinLength = schIUScale.MilsToIU( 150 );
+    const int      bodyWidth = schIUScale.MilsToIU( 600 );
+    const VECTOR2I textSize( schIUScale.MilsToIU( 50 ), schIUScale.MilsToIU( 50 ) );
+    const int      penWidth = schIUScale.MilsToIU( 6 );
+
+    KIFONT::METRICS metrics;
+
+    aPlotter.SetColor( COLOR4D( RED ) );
+    aPlotter.Rect( aPos, aPos + VECTOR2I( bodyWidth, pinCount * pinPitch ), FILL_T::NO_FILL,
+                   penWidth );
+
+    for( int pin = 0; pin < pinCount; ++pin )
+    {
+        int y = aPos.y + pinPitch / 2 + pin * pinPitch;
+
+        aPlotter.SetColor( COLOR4D( RED ) );
+        aPlotter.MoveTo( VECTOR2I( aPos.x - pinLength, y ) );
+        aPlotter.FinishTo( VECTOR2I( aPos.x, y ) );
+
+        aPlotter.SetColor( COLOR4D( DARKCYAN ) );
+        aPlotter.Text( VECTOR2I( aPos.x - pinLength / 2, y ), COLOR4D( DARKCYAN ),
+                       wxString::Format( wxT( "%d" ), pin + 1 ), ANGLE_0, textSize,
+                       GR_TEXT_H_ALIGN_CENTER, GR_TEXT_V_ALIGN_BOTTOM, penWidth, false, false,
+                       false, nullptr, metrics );
+
+        aPlotter.Text( VECTOR2I( aPos.x + textSize.x, y ), COLOR4D( DARKCYAN ),
+                       pin == 0 ? wxString( wxT( "VCC" ) ) : wxString::Format( wxT( "IO%d" ), pin ),
+                       ANGLE_0, textSize, GR_TEXT_H_ALIGN_LEFT, GR_TEXT_V_ALIGN_CENTER,
+                       penWidth, false, false, false, nullptr, metrics );
+
+        // A wire to the next symbol
+        aPlotter.SetColor( COLOR4D( GREEN ) );
+        aPlotter.MoveTo( VECTOR2I( aPos.x - pinLength, y ) );
+        aPlotter.FinishTo( VECTOR2I( aPos.x - pinLength * 3, y ) );
+    }
+
+    aPlotter.Text( aPos - VECTOR2I( 0, textSize.y ), COLOR4D( DARKCYAN ),
+                   wxString::Format( wxT( "U%d" ), aIndex + 1 ), ANGLE_0, textSize,
+                   GR_TEXT_H_ALIGN_LEFT, GR_TEXT_V_ALIGN_BOTTOM, penWidth, false, false, false,
+                   nullptr, metrics );
+}
+
+
+static void plotPads( PDF_PLOTTER& aPlotter, int aCount )
+{
+    const int pitch = pcbIUScale.mmToIU( 1.0 );
+    VECTOR2I  size( pcbIUScale.mmToIU( 0.6 ), pcbIUScale.mmToIU( 0.3 ) );
+
+    aPlotter.SetColor( COLOR4D( RED ) );
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        VECTOR2I pos( ( ii % 200 ) * pitch, ( ii / 200 ) * pitch );
+
+        aPlotter.FlashPadRoundRect( pos, size, size.y / 4, ANGLE_0, FILLED, nullptr );
+    }
+}
+
+
+enum PDF_PLOTTER_BENCHMARK_RET_CODES
+{
+    CANNOT_WRITE = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int pdf_plotter_benchmark_main( int argc, char* argv[] )
+{
+    int sheetCount = 50;
+
+    if( argc > 1 )
+        sheetCount = std::max( 1, atoi( argv[1] ) );
+
+    wxString                  fileName = wxFileName::CreateTempFileName( wxT( "pdf_bench" ) );
+    BENCHMARK_RENDER_SETTINGS renderSettings;
+    PDF_PLOTTER               plotter;
+    PAGE_INFO                 pageInfo( PAGE_INFO::A3 );
+
+    plotter.SetRenderSettings( &renderSettings );
+    plotter.SetPageSettings( pageInfo );
+    plotter.SetColorMode( true );
+    plotter.SetViewport( VECTOR2I( 0, 0 ), schIUScale.IU_PER_MILS / 10, 1.0, false );
+
+    if( !plotter.OpenFile( fileName ) )
+        return PDF_PLOTTER_BENCHMARK_RET_CODES::CANNOT_WRITE;
+
+    PROF_TIMER timer;
+
+    // Sheets of 6 x 4 symbols
+    for( int sheet = 0; sheet < sheetCount; ++sheet )
+    {
+        wxString pageNumber = wxString::Format( wxT( "%d" ), sheet + 1 );
+
+        if( sheet == 0 )
+            plotter.StartPlot( pageNumber );
+        else
+            plotter.StartPage( pageNumber );
+
+        for( int ii = 0; ii < 24; ++ii )
+        {
+            VECTOR2I pos( schIUScale.MilsToIU( 1000 + ( ii % 6 ) * 2300 ),
+                          schIUScale.MilsToIU( 1000 + ( ii / 6 ) * 2300 ) );
+
+            plotSymbol( plotter, pos, sheet * 24 + ii );
+        }
+
+        plotter.ClosePage();
+    }
+
+    double schTimeMs = timer.msecs();
+
+    timer.Start();
+
+    plotter.SetViewport( VECTOR2I( 0, 0 ), pcbIUScale.IU_PER_MILS / 10, 1.0, false );
+    plotter.StartPage( wxString::Format( wxT( "%d" ), sheetCount + 1 ) );
+    plotPads( plotter, 20000 );
+    plotter.EndPlot();
+
+    double pcbTimeMs = timer.msecs();
+
+    wxULongLong size = wxFileName::GetSize( fileName );
+
+    wxRemoveFile( fileName );
+
+    printf( "%-24s %10s %12s\n", "content", "pages", "time [ms]" );
+    printf( "%-24s %10d %12.1f\n", "schematic sheets", sheetCount, schTimeMs );
+    printf( "%-24s %10d %12.1f\n", "pads (with EndPlot)", 1, pcbTimeMs );
+    printf( "file size: %s bytes\n", size.ToString().ToStdString().c_str() );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "pdf_plotter_benchmark",
+        "Benchmark plotting a multi-sheet schematic-like document to PDF",
+        pdf_plotter_benchmark_main,
+} );
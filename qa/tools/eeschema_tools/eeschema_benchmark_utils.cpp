@@ -0,0 +1,98 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "eeschema_benchmark_utils.h"
+
+#include <base_units.h>
+#include <sch_label.h>
+#include <sch_line.h>
+#include <sch_screen.h>
+
+
+namespace KI_TEST
+{
+
+std::vector<SCH_LINE*> FillScreenWithWires( SCH_SCREEN& aScreen, int aWireCount,
+                                            int aWiresPerRow, bool aRowLabels )
+{
+    const int              pitch = schIUScale.MilsToIU( 200 );
+    std::vector<SCH_LINE*> wires;
+
+    for( int ii = 0; ii < aWireCount / 2; ++ii )
+    {
+        VECTOR2I start( ( ii % aWiresPerRow ) * pitch, ( ii / aWiresPerRow ) * pitch );
+        VECTOR2I middle = start + VECTOR2I( pitch / 2, 0 );
+
+        SCH_LINE* wire = new SCH_LINE( start, LAYER_WIRE );
+        wire->SetEndPoint( start + VECTOR2I( pitch, 0 ) );
+
+        SCH_LINE* stub = new SCH_LINE( middle, LAYER_WIRE );
+        stub->SetEndPoint( middle + VECTOR2I( 0, pitch / 2 ) );
+
+        aScreen.Append( wire );
+        aScreen.Append( stub );
+
+        wires.push_back( wire );
+        wires.push_back( stub );
+
+        if( aRowLabels && ii % aWiresPerRow == 0 )
+            aScreen.Append( new SCH_LABEL( start, wxString::Format( wxT( "ROW%d" ), ii ) ) );
+    }
+
+    return wires;
+}
+
+
+BENCHMARK_SYMBOLS::BENCHMARK_SYMBOLS() :
+        m_passive( wxT( "Passive" ) ),
+        m_quad( wxT( "Quad" ) )
+{
+    m_path.push_back( &m_root );
+    m_quad.SetUnitCount( 4 );
+}
+
+
+void BENCHMARK_SYMBOLS::Create( int aCount,
+                                const std::function<void( SCH_SYMBOL& aSymbol,
+                                                          int aIndex )>& aSetup )
+{
+    m_symbols.clear();
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        VECTOR2I pos( ( ii % 100 ) * schIUScale.MilsToIU( 500 ),
+                      ( ii / 100 ) * schIUScale.MilsToIU( 500 ) );
+
+        bool        isQuad = IsQuad( ii );
+        int         unit = isQuad ? ( ii / 5 ) % 4 + 1 : 1;
+        LIB_SYMBOL& libSymbol = isQuad ? m_quad : m_passive;
+        LIB_ID      libId( wxT( "bench" ), libSymbol.GetName() );
+
+        auto symbol = std::make_unique<SCH_SYMBOL>( libSymbol, libId, &m_path, unit, 0, pos );
+
+        aSetup( *symbol, ii );
+        m_symbols.push_back( std::move( symbol ) );
+    }
+}
+
+} // namespace KI_TEST
@@ -0,0 +1,86 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef EESCHEMA_BENCHMARK_UTILS_H
+#define EESCHEMA_BENCHMARK_UTILS_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <lib_symbol.h>
+#include <sch_sheet.h>
+#include <sch_sheet_path.h>
+#include <sch_symbol.h>
+
+class SCH_LINE;
+class SCH_SCREEN;
+
+
+/**
+ * Helpers generating the designs used by the eeschema benchmarks.
+ */
+namespace KI_TEST
+{
+
+/**
+ * Fill \a aScreen with dense wiring: rows of \a aWiresPerRow chained horizontal wires, with a
+ * vertical stub ending on the middle of each of them (a T which needs a junction).  Wires
+ * are 200 mils long.
+ *
+ * @param aWireCount is the number of wires to add, half of them being stubs.
+ * @param aRowLabels adds a label at the start of each row, so each row is a named net.
+ * @return the added wires and stubs.
+ */
+std::vector<SCH_LINE*> FillScreenWithWires( SCH_SCREEN& aScreen, int aWireCount,
+                                            int aWiresPerRow, bool aRowLabels = false );
+
+
+/**
+ * A flat design of generated symbols on a grid of 100 columns.  One symbol in five is a unit
+ * of a quad (4 units) IC, cycling through the units; the others are passives.
+ */
+struct BENCHMARK_SYMBOLS
+{
+    BENCHMARK_SYMBOLS();
+
+    /**
+     * Replace the symbols by \a aCount new ones, each of them passed with its index to
+     * \a aSetup to set its reference and fields.
+     */
+    void Create( int aCount,
+                 const std::function<void( SCH_SYMBOL& aSymbol, int aIndex )>& aSetup );
+
+    /// One symbol in five is a unit of a quad IC
+    static bool IsQuad( size_t aIndex ) { return aIndex % 5 == 0; }
+
+    SCH_SHEET                                m_root;
+    SCH_SHEET_PATH                           m_path;
+    LIB_SYMBOL                               m_passive;
+    LIB_SYMBOL                               m_quad;
+    std::vector<std::unique_ptr<SCH_SYMBOL>> m_symbols;
+};
+
+} // namespace KI_TEST
+
+#endif // EESCHEMA_BENCHMARK_UTILS_H
@@ -0,0 +1,57 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_program.h>
+
+#include <eeschema_settings.h>
+#include <mock_pgm_base.h>
+#include <pgm_base.h>
+#include <settings/settings_manager.h>
+#include <symbol_editor/symbol_editor_settings.h>
+
+#include <wx/app.h>
+#include <wx/init.h>
+
+
+int main( int argc, char** argv )
+{
+    // Schematic items need the settings (and the rest of Pgm) to be set up, as in the unit tests
+    SetPgm( new MOCK_PGM_BASE() );
+
+    wxApp::SetInstance( new wxAppConsole );
+    wxInitialize( argc, argv );
+
+    Pgm().InitPgm( true, true, true );
+    Pgm().GetSettingsManager().RegisterSettings( new EESCHEMA_SETTINGS, false );
+    Pgm().GetSettingsManager().RegisterSettings( new SYMBOL_EDITOR_SETTINGS, false );
+    Pgm().GetSettingsManager().Load();
+
+    KI_TEST::COMBINED_UTILITY c_util;
+
+    int ret = c_util.HandleCommandLine( argc, argv );
+
+    Pgm().Destroy();
+    wxUninitialize();
+
+    return ret;
+}
@@ -0,0 +1,130 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <core/profile.h>
+#include <sch_reference_list.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <eeschema_benchmark_utils.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+
+/**
+ * Annotate a flat design with many resistors and some quad (4 units) ICs, first from scratch,
+ * then again after clearing the annotation of one symbol in seven.  Runs several design sizes so
+ * the scaling shows.
+ */
+
+
+struct ANNOTATE_BENCHMARK : public KI_TEST::BENCHMARK_SYMBOLS
+{
+    void CreateSymbols( int aCount )
+    {
+        Create( aCount,
+                [&]( SCH_SYMBOL& aSymbol, int aIndex )
+                {
+                    bool isQuad = IsQuad( aIndex );
+
+                    aSymbol.SetRef( &m_path, isQuad ? wxT( "U?" ) : wxT( "R?" ) );
+                    aSymbol.SetValueFieldText( isQuad ? wxString( wxT( "LM324" ) )
+                                                      : wxString::Format( wxT( "%dk" ),
+                                                                          aIndex % 7 + 1 ) );
+                } );
+    }
+
+    /// Annotate all the symbols, returning the time in ms.
+    double Annotate()
+    {
+        SCH_REFERENCE_LIST           refs;
+        SCH_MULTI_UNIT_REFERENCE_MAP lockedUnits;
+
+        for( const std::unique_ptr<SCH_SYMBOL>& symbol : m_symbols )
+        {
+            m_path.AppendSymbol( refs, symbol.get() );
+            m_path.AppendMultiUnitSymbol( lockedUnits, symbol.get() );
+        }
+
+        refs.SplitReferences();
+
+        PROF_TIMER timer;
+
+        refs.AnnotateByOptions( SORT_BY_X_POSITION, INCREMENTAL_BY_REF, 0, lockedUnits,
+                                SCH_REFERENCE_LIST(), false );
+
+        double timeMs = timer.msecs();
+
+        refs.UpdateAnnotation();
+
+        return timeMs;
+    }
+
+    /// Clear the annotation of one symbol in \a aStep.
+    void ClearSome( int aStep )
+    {
+        for( size_t ii = 0; ii < m_symbols.size(); ii += aStep )
+        {
+            m_symbols[ii]->SetRef( &m_path, IsQuad( ii ) ? wxT( "U?" ) : wxT( "R?" ) );
+        }
+    }
+};
+
+
+int sch_annotate_benchmark_main( int argc, char* argv[] )
+{
+    int symbolCount = 20000;
+
+    if( argc > 1 )
+        symbolCount = std::max( 4, atoi( argv[1] ) );
+
+    ANNOTATE_BENCHMARK bench;
+
+    printf( "%-10s %16s %16s\n", "symbols", "full [ms]", "partial [ms]" );
+
+    for( int count : { symbolCount / 4, symbolCount / 2, symbolCount } )
+    {
+        bench.CreateSymbols( count );
+
+        double fullTimeMs = bench.Annotate();
+
+        bench.ClearSome( 7 );
+
+        double partialTimeMs = bench.Annotate();
+
+        printf( "%-10d %16.1f %16.1f\n", count, fullTimeMs, partialTimeMs );
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "sch_annotate_benchmark",
+        "Benchmark annotating designs with many symbols",
+        sch_annotate_benchmark_main,
+} );
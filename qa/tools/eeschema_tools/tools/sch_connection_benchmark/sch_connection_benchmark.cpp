@@ -0,0 +1,140 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <core/profile.h>
+#include <sch_line.h>
+#include <sch_screen.h>
+#include <trigo.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <eeschema_benchmark_utils.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+
+
+/**
+ * Fill a sheet with dense wiring: rows of chained horizontal wires, with a vertical stub
+ * ending on the middle of each of them (a T which needs a junction).  Then time the connection
+ * point lookups done when dragging a selection of wires around.
+ */
+
+
+static const int WIRES_PER_ROW = 200;
+
+
+int sch_connection_benchmark_main( int argc, char* argv[] )
+{
+    int wireCount = 50000;
+    int movedCount = 1000;
+
+    if( argc > 1 )
+        wireCount = std::max( 2, atoi( argv[1] ) );
+
+    if( argc > 2 )
+        movedCount = std::max( 1, atoi( argv[2] ) );
+
+    SCH_SCREEN             screen;
+    std::vector<SCH_LINE*> wires = KI_TEST::FillScreenWithWires( screen, wireCount,
+                                                                  WIRES_PER_ROW );
+    std::deque<EDA_ITEM*>  moved;
+
+    movedCount = std::min<int>( movedCount, wires.size() );
+
+    // Spread the moved wires over the whole sheet
+    for( int ii = 0; ii < movedCount; ++ii )
+        moved.push_back( wires[ (size_t) ii * wires.size() / movedCount ] );
+
+    size_t     found = 0;
+    PROF_TIMER timer;
+
+    // What the wire tools used to do: collect all the connections of the screen, then test each
+    // of them against the moved wires.
+    std::vector<VECTOR2I> connections = screen.GetConnections();
+
+    for( EDA_ITEM* item : moved )
+    {
+        SCH_LINE* wire = static_cast<SCH_LINE*>( item );
+
+        for( const VECTOR2I& pt : connections )
+        {
+            if( IsPointOnSegment( wire->GetStartPoint(), wire->GetEndPoint(), pt ) )
+                found++;
+        }
+    }
+
+    double allTimeMs = timer.msecs();
+    size_t allFound = found;
+
+    found = 0;
+    timer.Start();
+
+    for( EDA_ITEM* item : moved )
+    {
+        SCH_LINE* wire = static_cast<SCH_LINE*>( item );
+
+        found += screen.GetConnectionsOnSegment( wire->GetStartPoint(),
+                                                 wire->GetEndPoint() ).size();
+    }
+
+    double segmentTimeMs = timer.msecs();
+    size_t segmentFound = found;
+
+    timer.Start();
+    found = screen.GetNeededJunctions( moved ).size();
+    double junctionsTimeMs = timer.msecs();
+    size_t junctionsFound = found;
+
+    found = 0;
+    timer.Start();
+
+    for( EDA_ITEM* item : moved )
+    {
+        for( const VECTOR2I& pt : static_cast<SCH_LINE*>( item )->GetConnectionPoints() )
+        {
+            if( screen.IsExplicitJunctionNeeded( pt ) )
+                found++;
+        }
+    }
+
+    double explicitTimeMs = timer.msecs();
+
+    printf( "%d wires, %d moved\n", wireCount, movedCount );
+    printf( "%-32s %10s %12s\n", "query", "found", "time [ms]" );
+    printf( "%-32s %10zu %12.1f\n", "GetConnections + filter", allFound, allTimeMs );
+    printf( "%-32s %10zu %12.1f\n", "GetConnectionsOnSegment", segmentFound, segmentTimeMs );
+    printf( "%-32s %10zu %12.1f\n", "GetNeededJunctions", junctionsFound, junctionsTimeMs );
+    printf( "%-32s %10zu %12.1f\n", "IsExplicitJunctionNeeded", found, explicitTimeMs );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "sch_connection_benchmark",
+        "Benchmark the connection point lookups of a sheet with dense wiring",
+        sch_connection_benchmark_main,
+} );
@@ -0,0 +1,120 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <base_units.h>
+#include <connection_graph.h>
+#include <core/profile.h>
+#include <schematic.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
+#include <settings/settings_manager.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <eeschema_benchmark_utils.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+
+/**
+ * Build a design which uses the same "channel" sheet many times, like a multi-channel board,
+ * then time a full connectivity recalculation with and without replaying the item links of
+ * the first instance of the sheet for the other ones.
+ */
+
+
+static const int WIRES_PER_ROW = 50;
+
+
+int sch_connection_graph_benchmark_main( int argc, char* argv[] )
+{
+    int instanceCount = 64;
+    int wireCount = 2000;
+
+    if( argc > 1 )
+        instanceCount = std::max( 1, atoi( argv[1] ) );
+
+    if( argc > 2 )
+        wireCount = std::max( 2, atoi( argv[2] ) );
+
+    SETTINGS_MANAGER manager( true );
+    manager.LoadProject( wxEmptyString );
+
+    SCHEMATIC schematic( nullptr );
+    schematic.SetProject( &manager.Prj() );
+
+    SCH_SHEET* root = new SCH_SHEET( &schematic );
+    schematic.SetRoot( root );
+
+    SCH_SCREEN* rootScreen = new SCH_SCREEN( &schematic );
+    root->SetScreen( rootScreen );
+
+    SCH_SCREEN* channel = new SCH_SCREEN( &schematic );
+    channel->SetFileName( wxT( "channel.kicad_sch" ) );
+    // Rows of chained wires, each with a stub ending on its middle and a label at its start
+    KI_TEST::FillScreenWithWires( *channel, wireCount, WIRES_PER_ROW, true );
+
+    for( int ii = 0; ii < instanceCount; ++ii )
+    {
+        VECTOR2I   pos( ( ii % 8 ) * schIUScale.MilsToIU( 2000 ),
+                        ( ii / 8 ) * schIUScale.MilsToIU( 2000 ) );
+        SCH_SHEET* sheet = new SCH_SHEET( root, pos );
+
+        sheet->SetName( wxString::Format( wxT( "Channel %d" ), ii + 1 ) );
+        sheet->SetFileName( channel->GetFileName() );
+        sheet->SetScreen( channel );
+        rootScreen->Append( sheet );
+    }
+
+    schematic.CurrentSheet().push_back( root );
+
+    SCH_SHEET_LIST sheets = schematic.BuildUnorderedSheetList();
+
+    printf( "%d instances of a sheet with %d wires\n", instanceCount, wireCount );
+    printf( "%-32s %10s %12s\n", "item links", "nets", "time [ms]" );
+
+    for( bool reuse : { false, true } )
+    {
+        CONNECTION_GRAPH graph( &schematic );
+        graph.SetReuseScreenLinks( reuse );
+
+        PROF_TIMER timer;
+        graph.Recalculate( sheets, true );
+        timer.Stop();
+
+        printf( "%-32s %10zu %12.1f\n", reuse ? "replayed for each instance"
+                                              : "searched for each instance",
+                graph.GetNetMap().size(), timer.msecs() );
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "sch_connection_graph_benchmark",
+        "Benchmark the connectivity recalculation of a design reusing one sheet many times",
+        sch_connection_graph_benchmark_main,
+} );
@@ -0,0 +1,179 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <core/profile.h>
+#include <fields_data_model.h>
+#include <sch_reference_list.h>
+#include <settings/bom_settings.h>
+#include <template_fieldnames.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <eeschema_benchmark_utils.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+/**
+ * Drive the symbol fields table model (without a grid) on a generated flat design: resistors
+ * and capacitors with a few dozen distinct values and footprints, and some quad (4 units)
+ * ICs.  Times the operations the symbol fields table dialog and the BOM export run.
+ */
+
+
+int sch_fields_table_benchmark_main( int argc, char* argv[] )
+{
+    int symbolCount = 30000;
+
+    if( argc > 1 )
+        symbolCount = std::max( 1, atoi( argv[1] ) );
+
+    KI_TEST::BENCHMARK_SYMBOLS design;
+    SCH_REFERENCE_LIST         refs;
+
+    // The quad ICs are LM324s, the other symbols are resistors and capacitors
+    design.Create( symbolCount,
+            [&]( SCH_SYMBOL& aSymbol, int aIndex )
+            {
+                wxString ref;
+                wxString value;
+                wxString footprint;
+
+                if( KI_TEST::BENCHMARK_SYMBOLS::IsQuad( aIndex ) )
+                {
+                    ref = wxString::Format( wxT( "U%d" ), aIndex / 20 + 1 );
+                    value = wxT( "LM324" );
+                    footprint = wxT( "Package_SO:SOIC-14_3.9x8.7mm_P1.27mm" );
+                }
+                else
+                {
+                    bool isCap = aIndex % 2;
+
+                    ref = wxString::Format( isCap ? wxT( "C%d" ) : wxT( "R%d" ), aIndex + 1 );
+                    value = wxString::Format( isCap ? wxT( "%dn" ) : wxT( "%dk" ),
+                                              aIndex % 24 + 1 );
+                    footprint = aIndex % 3 ? wxT( "Resistor_SMD:R_0402_1005Metric" )
+                                           : wxT( "Resistor_SMD:R_0603_1608Metric" );
+                }
+
+                aSymbol.SetRef( &design.m_path, ref );
+                aSymbol.SetValueFieldText( value );
+                aSymbol.SetFootprintFieldText( footprint );
+
+                SCH_FIELD* mpn = aSymbol.AddField( SCH_FIELD( aSymbol.GetPosition(), -1, &aSymbol,
+                                                              wxT( "MPN" ) ) );
+                mpn->SetText( value + wxT( "-" ) + footprint.AfterFirst( ':' ).BeforeFirst( '_' ) );
+            } );
+
+    for( const std::unique_ptr<SCH_SYMBOL>& symbol : design.m_symbols )
+        design.m_path.AppendSymbol( refs, symbol.get() );
+
+    PROF_TIMER timer;
+
+    FIELDS_EDITOR_GRID_DATA_MODEL model( refs );
+
+    for( int i = 0; i < MANDATORY_FIELDS; ++i )
+    {
+        model.AddColumn( TEMPLATE_FIELDNAME::GetDefaultFieldName( i ),
+                         TEMPLATE_FIELDNAME::GetDefaultFieldName( i, true ), false );
+    }
+
+    model.AddColumn( wxT( "MPN" ), wxT( "MPN" ), true );
+    model.AddColumn( FIELDS_EDITOR_GRID_DATA_MODEL::QUANTITY_VARIABLE, wxT( "Qty" ), true );
+
+    double setupTimeMs = timer.msecs();
+
+    printf( "%d symbols\n", symbolCount );
+    printf( "%-32s %10s %12s\n", "operation", "rows", "time [ms]" );
+    printf( "%-32s %10s %12.1f\n", "build data store", "", setupTimeMs );
+
+    auto run = [&]( const char* aName, const std::function<void()>& aFunc )
+               {
+                   timer.Start();
+                   aFunc();
+                   printf( "%-32s %10d %12.1f\n", aName, model.GetNumberRows(), timer.msecs() );
+               };
+
+    run( "rebuild (not grouped)",
+         [&]()
+         {
+             model.ApplyBomPreset( BOM_PRESET::DefaultEditing() );
+         } );
+
+    run( "rebuild (by value and footprint)",
+         [&]()
+         {
+             model.ApplyBomPreset( BOM_PRESET::GroupedByValueFootprint() );
+         } );
+
+    run( "sort by value",
+         [&]()
+         {
+             model.SetSorting( model.GetFieldNameCol( GetCanonicalFieldName( VALUE_FIELD ) ),
+                               true );
+             model.SortRows();
+         } );
+
+    run( "filter",
+         [&]()
+         {
+             model.SetFilter( wxT( "R1*" ) );
+             model.RebuildRows();
+             model.SetFilter( wxEmptyString );
+         } );
+
+    run( "update 100 symbols and regroup",
+         [&]()
+         {
+             SCH_REFERENCE_LIST changed;
+
+             for( unsigned ii = 0; ii < refs.GetCount() && ii < 100; ++ii )
+             {
+                 refs[ii].GetSymbol()->SetValueFieldText( wxT( "changed" ) );
+                 changed.AddItem( refs[ii] );
+             }
+
+             model.UpdateReferences( changed );
+             model.RebuildRows();
+         } );
+
+    run( "export CSV",
+         [&]()
+         {
+             model.Export( BOM_FMT_PRESET::CSV() );
+         } );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "sch_fields_table_benchmark",
+        "Benchmark the symbol fields table model on a large design",
+        sch_fields_table_benchmark_main,
+} );
@@ -0,0 +1,148 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_arc.h>
+#include <geometry/shape_poly_set.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <board.h>
+#include <board_design_settings.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include <core/profile.h>
+
+#include <cstdio>
+
+
+/**
+ * Count the vertices the OpenGL painter emits for zone fills and track arcs, for the full
+ * detail geometry and for each level of detail band (see VIEW::SetLODThreshold()).
+ */
+
+
+struct LOD_VERTEX_STATS
+{
+    size_t m_zoneVertices = 0;
+    size_t m_arcVertices = 0;
+    double m_timeMs = 0.0;
+};
+
+
+static size_t triangulatedVertexCount( SHAPE_POLY_SET& aPoly )
+{
+    size_t count = 0;
+
+    aPoly.CacheTriangulation( true, true );
+
+    for( unsigned int ii = 0; ii < aPoly.TriangulatedPolyCount(); ++ii )
+        count += aPoly.TriangulatedPolygon( ii )->GetTriangleCount() * 3;
+
+    return count;
+}
+
+
+static LOD_VERTEX_STATS countVertices( BOARD* aBoard, int aMaxError, int aTolerance )
+{
+    LOD_VERTEX_STATS stats;
+    PROF_TIMER       timer;
+
+    for( ZONE* zone : aBoard->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            SHAPE_POLY_SET fill = *zone->GetFilledPolysList( layer );
+
+            if( aTolerance > aMaxError )
+                fill.Decimate( aTolerance );
+
+            stats.m_zoneVertices += triangulatedVertexCount( fill );
+        }
+    }
+
+    for( PCB_TRACK* track : aBoard->Tracks() )
+    {
+        if( track->Type() != PCB_ARC_T )
+            continue;
+
+        PCB_ARC*  arc = static_cast<PCB_ARC*>( track );
+        SHAPE_ARC shape( arc->GetStart(), arc->GetMid(), arc->GetEnd(), arc->GetWidth() );
+
+        stats.m_arcVertices +=
+                shape.ConvertToPolyline( std::max( aMaxError, aTolerance ) ).PointCount();
+    }
+
+    stats.m_timeMs = timer.msecs();
+
+    return stats;
+}
+
+
+enum LOD_VERTEX_COUNT_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int lod_vertex_count_main( int argc, char* argv[] )
+{
+    std::string filename;
+
+    if( argc > 1 )
+        filename = argv[1];
+
+    auto brd = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !brd )
+        return LOD_VERTEX_COUNT_RET_CODES::LOAD_FAILED;
+
+    // Same bands as PCB_DRAW_PANEL_GAL: the first one starts at 4x the board max error and
+    // each following one covers a four times larger pixel size.
+    const int maxError = brd->GetDesignSettings().m_MaxError;
+    const int bandCount = 6;
+    int       tolerance = 0;
+
+    printf( "%-6s %14s %14s %14s %10s\n", "band", "tolerance [nm]", "zone vertices",
+            "arc vertices", "time [ms]" );
+
+    for( int band = 0; band < bandCount; ++band )
+    {
+        LOD_VERTEX_STATS stats = countVertices( brd.get(), maxError, tolerance );
+
+        printf( "%-6d %14d %14zu %14zu %10.1f\n", band, tolerance, stats.m_zoneVertices,
+                stats.m_arcVertices, stats.m_timeMs );
+
+        tolerance = tolerance ? tolerance * 4 : maxError * 4;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "lod_vertex_count",
+        "Count zone fill and arc vertices emitted at each level of detail band",
+        lod_vertex_count_main,
+} );
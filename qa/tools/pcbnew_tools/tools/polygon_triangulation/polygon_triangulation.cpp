@@ -37,6 +37,7 @@
 #include <core/profile.h>
 
 #include <atomic>
+#include <iostream>
 #include <thread>
 #include <unordered_set>
 #include <utility>
@@ -199,6 +200,43 @@ aResult->clear();
 }
 
 
+/**
+ * Estimate the heap memory held by the zone fills of a board.  Vector capacities are used
+ * rather than sizes since that is what is actually allocated.
+ */
+static size_t zoneFillMemoryUsage( BOARD* aBoard, size_t& aVertexCount )
+{
+    size_t bytes = 0;
+
+    aVertexCount = 0;
+
+    for( ZONE* zone : aBoard->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            std::shared_ptr<SHAPE_POLY_SET> fill = zone->GetFilledPolysList( layer );
+
+            for( int ii = 0; ii < fill->OutlineCount(); ++ii )
+            {
+                const SHAPE_POLY_SET::POLYGON& poly = fill->CPolygon( ii );
+
+                bytes += poly.capacity() * sizeof( SHAPE_LINE_CHAIN );
+
+                for( const SHAPE_LINE_CHAIN& chain : poly )
+                {
+                    aVertexCount += chain.PointCount();
+                    bytes += chain.CPoints().capacity() * sizeof( VECTOR2I );
+                    bytes += chain.CShapes().capacity() * sizeof( SHAPE_LINE_CHAIN::shape_idx_pair );
+                    bytes += chain.CArcs().capacity() * sizeof( SHAPE_ARC );
+                }
+            }
+        }
+    }
+
+    return bytes;
+}
+
+
 enum POLY_TRI_RET_CODES
 {
     LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
@@ -218,6 +256,12 @@ int polygon_triangulation_main( int argc, char *argv[] )
         return POLY_TRI_RET_CODES::LOAD_FAILED;
 
 
+    size_t vertexCount = 0;
+    size_t fillBytes = zoneFillMemoryUsage( brd.get(), vertexCount );
+
+    std::cout << "Zone fills: " << vertexCount << " vertices, "
+              << fillBytes / 1024 << " KiB" << std::endl;
+
     PROF_TIMER cnt( "allBoard" );
 
 
@@ -337,6 +337,10 @@ bool PNS_LOG_FILE::Load( const wxFileName& logFileName, REPORTER* aRpt )
                       RPT_SEVERITY_WARNING );
     }
 
+    // The optimizer time budget is only meant for interactive routing.  A replay must give the
+    // same result whatever the speed of the machine running it.
+    m_routerSettings->SetOptimizerTimeLimit( 0 );
+
     aRpt->Report( wxString::Format( wxT( "Loading project settings from '%s'" ),
                                     fname_settings.GetFullPath() ) );
 
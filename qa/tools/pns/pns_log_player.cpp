@@ -27,6 +27,8 @@
 
 #include <pcbnew_utils/board_test_utils.h>
 
+#include <core/profile.h>
+
 #define PNSLOGINFO PNS::DEBUG_DECORATOR::SRC_LOCATION_INFO( __FILE__, __FUNCTION__, __LINE__ )
 
 using namespace PNS;
@@ -102,6 +104,8 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
     int eventIdx = 0;
     int totalEvents = aLog->Events().size();
 
+    m_eventStats.clear();
+
     for( auto evt : aLog->Events() )
     {
         if( eventIdx < aFrom || ( aTo >= 0 && eventIdx > aTo ) )
@@ -113,6 +117,10 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
 
         eventIdx++;
 
+        const int64_t queriesBefore = m_router->GetWorld()->QueryCount();
+        const int64_t branchesBefore = m_router->GetWorld()->BranchCount();
+        PROF_TIMER    eventTimer;
+
         switch( evt.type )
         {
         case LOGGER::EVT_START_ROUTE:
@@ -207,6 +215,16 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
         default: break;
         }
 
+        eventTimer.Stop();
+
+        EVENT_STATS stats;
+        stats.m_type = evt.type;
+        stats.m_timeMs = eventTimer.msecs();
+        stats.m_queries = m_router->GetWorld()->QueryCount() - queriesBefore;
+        stats.m_branches = m_router->GetWorld()->BranchCount() - branchesBefore;
+        stats.m_joints = m_router->GetWorld()->JointCount();
+        m_eventStats.push_back( stats );
+
         PNS::NODE* node = nullptr;
 
 #if 0
@@ -26,6 +26,7 @@
 #include <map>
 #include <pcbnew/board.h>
 
+#include <router/pns_logger.h>
 #include <router/pns_routing_settings.h>
 #include <router/pns_kicad_iface.h>
 #include <router/pns_router.h>
@@ -93,6 +94,16 @@ private:
 class PNS_LOG_PLAYER
 {
 public:
+    ///< Cost of replaying a single logged event.
+    struct EVENT_STATS
+    {
+        PNS::LOGGER::EVENT_TYPE m_type;
+        double                  m_timeMs;   ///< wall time spent in the router
+        int64_t                 m_queries;  ///< collision queries made on the world
+        int64_t                 m_branches; ///< nodes branched from the world
+        int                     m_joints;   ///< joints in the world after the event
+    };
+
     PNS_LOG_PLAYER();
     ~PNS_LOG_PLAYER();
 
@@ -107,6 +118,10 @@ public:
     void SetTimeLimit( uint64_t microseconds ) { m_timeLimitUs = microseconds; }
 
     bool CompareResults( PNS_LOG_FILE* aLog );
+
+    ///< Return the per-event statistics gathered during the last ReplayLog() call.
+    const std::vector<EVENT_STATS>& GetEventStats() const { return m_eventStats; }
+
     const PNS_LOG_FILE::COMMIT_STATE GetRouterUpdatedItems();
 
 private:
@@ -120,6 +135,7 @@ private:
     std::unique_ptr<PNS::ROUTING_SETTINGS>      m_routingSettings;
     uint64_t m_timeLimitUs;
     REPORTER* m_reporter;
+    std::vector<EVENT_STATS>                    m_eventStats;
 };
 
 #endif
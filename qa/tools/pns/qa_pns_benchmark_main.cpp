@@ -0,0 +1,251 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Headless router benchmark.  Replays a corpus of PNS_LOGGER event logs (the same layout as the
+ * pns_regressions test data: a tests.lst file listing one log directory per line), reports
+ * per-event latency percentiles together with NODE query/branch counts, and optionally
+ * compares the results against a previously written baseline.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <wx/cmdline.h>
+#include <wx/textfile.h>
+
+#include <reporter.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+#include <qa_utils/utility_program.h>
+
+#include "pns_log_file.h"
+#include "pns_log_player.h"
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", "displays help on the command line parameters",
+      wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "n", "iterations", "number of times each log is replayed (default 5)",
+      wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_OPTION, "b", "baseline", "baseline file to compare the results against",
+      wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_OPTION, "w", "write-baseline", "write the results to a baseline file",
+      wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_OPTION, "t", "threshold",
+      "allowed p90 latency regression against the baseline, in percent (default 20)",
+      wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, "corpus directory (default: pns_regressions test data)",
+      wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_NONE }
+};
+
+
+/// Latency differences below this are considered measurement noise.
+static const double NOISE_FLOOR_MS = 0.1;
+
+
+static const char* eventName( PNS::LOGGER::EVENT_TYPE aType )
+{
+    switch( aType )
+    {
+    case PNS::LOGGER::EVT_START_ROUTE: return "route-start";
+    case PNS::LOGGER::EVT_START_DRAG:  return "drag-start";
+    case PNS::LOGGER::EVT_FIX:         return "fix";
+    case PNS::LOGGER::EVT_MOVE:        return "move";
+    case PNS::LOGGER::EVT_ABORT:       return "abort";
+    case PNS::LOGGER::EVT_TOGGLE_VIA:  return "toggle-via";
+    case PNS::LOGGER::EVT_UNFIX:       return "unfix";
+    default:                           return "unknown";
+    }
+}
+
+
+struct EVENT_SUMMARY
+{
+    std::vector<double> m_timesMs;
+    int64_t             m_queries = 0;
+    int64_t             m_branches = 0;
+
+    double Percentile( double aPercent )
+    {
+        if( m_timesMs.empty() )
+            return 0.0;
+
+        std::sort( m_timesMs.begin(), m_timesMs.end() );
+
+        size_t idx = static_cast<size_t>( aPercent / 100.0 * ( m_timesMs.size() - 1 ) + 0.5 );
+
+        return m_timesMs[ std::min( idx, m_timesMs.size() - 1 ) ];
+    }
+};
+
+
+static std::vector<wxString> loadCorpus( const wxString& aCorpusDir )
+{
+    std::vector<wxString> logs;
+    wxTextFile            fp( aCorpusDir + wxT( "/tests.lst" ) );
+
+    if( !fp.Open() )
+        return logs;
+
+    for( size_t ii = 0; ii < fp.GetLineCount(); ++ii )
+    {
+        wxString line = fp.GetLine( ii ).Trim();
+
+        if( !line.IsEmpty() )
+            logs.push_back( aCorpusDir + wxT( "/" ) + line + wxT( "/pns" ) );
+    }
+
+    fp.Close();
+
+    return logs;
+}
+
+
+static std::map<std::string, double> loadBaseline( const wxString& aFilename )
+{
+    std::map<std::string, double> baseline;
+    std::ifstream                 fp( aFilename.ToStdString() );
+    std::string                   name;
+    double                        p90;
+
+    while( fp >> name >> p90 )
+        baseline[name] = p90;
+
+    return baseline;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    long     iterations = 5;
+    long     threshold = 20;
+    wxString baselineFile, writeBaselineFile;
+    wxString corpusDir = KI_TEST::GetPcbnewTestDataDir() + std::string( "/pns_regressions" );
+
+    cl_parser.Found( "iterations", &iterations );
+    cl_parser.Found( "threshold", &threshold );
+    cl_parser.Found( "baseline", &baselineFile );
+    cl_parser.Found( "write-baseline", &writeBaselineFile );
+
+    if( cl_parser.GetParamCount() > 0 )
+        corpusDir = cl_parser.GetParam( 0 );
+
+    std::vector<wxString> logs = loadCorpus( corpusDir );
+
+    if( logs.empty() )
+    {
+        printf( "No logs found in '%s'.\n", corpusDir.c_str().AsChar() );
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::map<std::string, EVENT_SUMMARY> summaries;
+
+    for( const wxString& logPath : logs )
+    {
+        PNS_LOG_FILE logFile;
+
+        if( !logFile.Load( wxFileName( logPath ), &NULL_REPORTER::GetInstance() ) )
+        {
+            printf( "Failed to load '%s', skipping.\n", logPath.c_str().AsChar() );
+            continue;
+        }
+
+        for( long ii = 0; ii < iterations; ++ii )
+        {
+            PNS_LOG_PLAYER player;
+
+            player.ReplayLog( &logFile, 0 );
+
+            for( const PNS_LOG_PLAYER::EVENT_STATS& stats : player.GetEventStats() )
+            {
+                EVENT_SUMMARY& summary = summaries[ eventName( stats.m_type ) ];
+
+                summary.m_timesMs.push_back( stats.m_timeMs );
+                summary.m_queries += stats.m_queries;
+                summary.m_branches += stats.m_branches;
+            }
+        }
+    }
+
+    printf( "%-12s %8s %10s %10s %10s %10s %12s %12s\n", "event", "count", "p50 [ms]",
+            "p90 [ms]", "p99 [ms]", "max [ms]", "queries/evt", "branches/evt" );
+
+    std::map<std::string, double> results;
+
+    for( auto& [ name, summary ] : summaries )
+    {
+        size_t count = summary.m_timesMs.size();
+
+        printf( "%-12s %8zu %10.3f %10.3f %10.3f %10.3f %12.1f %12.1f\n", name.c_str(), count,
+                summary.Percentile( 50 ), summary.Percentile( 90 ), summary.Percentile( 99 ),
+                summary.Percentile( 100 ), (double) summary.m_queries / count,
+                (double) summary.m_branches / count );
+
+        results[name] = summary.Percentile( 90 );
+    }
+
+    if( !writeBaselineFile.IsEmpty() )
+    {
+        std::ofstream fp( writeBaselineFile.ToStdString() );
+
+        for( const auto& [ name, p90 ] : results )
+            fp << name << " " << p90 << "\n";
+    }
+
+    bool regressed = false;
+
+    if( !baselineFile.IsEmpty() )
+    {
+        for( const auto& [ name, basePercentile ] : loadBaseline( baselineFile ) )
+        {
+            auto it = results.find( name );
+
+            if( it == results.end() )
+                continue;
+
+            double limit = basePercentile * ( 1.0 + threshold / 100.0 );
+
+            if( it->second > limit && it->second - basePercentile > NOISE_FLOOR_MS )
+            {
+                printf( "REGRESSION: '%s' p90 %.3f ms exceeds baseline %.3f ms by more than %ld%%\n",
+                        name.c_str(), it->second, basePercentile, threshold );
+                regressed = true;
+            }
+        }
+    }
+
+    return regressed ? KI_TEST::RET_CODES::TOOL_SPECIFIC : KI_TEST::RET_CODES::OK;
+}